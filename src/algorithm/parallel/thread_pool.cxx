@@ -0,0 +1,206 @@
+/**
+ *  \file
+ *  \brief  Work-stealing thread pool
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/parallel/thread_pool.hxx"
+
+
+namespace algorithm {
+namespace parallel {
+
+thread_local thread_pool * thread_pool::s_pool  = NULL;
+thread_local size_t        thread_pool::s_index = 0;
+
+
+thread_pool::thread_pool(size_t threads):
+    m_pending(0),
+    m_waiters(0),
+    m_stop(false)
+{
+    if (0 == threads) threads = std::thread::hardware_concurrency();
+    if (0 == threads) threads = 1;
+
+    // Workers' deques + the shared one
+    for (size_t i = 0; i <= threads; ++i)
+        m_deques.emplace_back(new deque);
+
+    for (size_t i = 0; i < threads; ++i)
+        m_workers.emplace_back(&thread_pool::worker, this, i);
+}
+
+
+bool thread_pool::get(size_t index, task_t & task) {
+    const size_t deques = m_deques.size();
+
+    // Own deque (LIFO)
+    {
+        deque & own = *m_deques[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --m_pending;
+            return true;
+        }
+    }
+
+    // Steal (FIFO)
+    for (size_t i = 1; i < deques; ++i) {
+        deque & victim = *m_deques[(index + i) % deques];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --m_pending;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void thread_pool::worker(size_t index) {
+    s_pool  = this;
+    s_index = index;
+
+    for (task_t task; ;) {
+        if (get(index, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [this]() { return m_stop || m_pending > 0; });
+
+        if (m_stop && 0 == m_pending) break;
+    }
+}
+
+
+void thread_pool::submit(task_t task) {
+    const size_t index = this == s_pool ? s_index : m_workers.size();
+
+    {
+        deque & dst = *m_deques[index];
+        std::lock_guard<std::mutex> lock(dst.mutex);
+        dst.tasks.push_back(std::move(task));
+        ++m_pending;
+    }
+
+    // Synchronise with idle workers' and waiters' predicate check
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_waiters) m_progress.notify_all();
+    }
+    m_idle.notify_one();
+}
+
+
+bool thread_pool::run_one() {
+    const size_t index = this == s_pool ? s_index : m_workers.size();
+
+    task_t task;
+    if (!get(index, task)) return false;
+
+    task();
+    return true;
+}
+
+
+void thread_pool::notify_progress() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_waiters) m_progress.notify_all();
+}
+
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_idle.notify_all();
+
+    for (auto & worker: m_workers) worker.join();
+}
+
+
+void task_group::run(thread_pool::task_t task) {
+    ++m_pending;
+
+    // The group may be gone once its last task is done
+    thread_pool * pool = &m_pool;
+
+    m_pool.submit([this, pool, task]() {
+        try {
+            task();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) m_exception = std::current_exception();
+        }
+
+        if (0 == --m_pending) pool->notify_progress();
+    });
+}
+
+
+void task_group::wait() {
+    while (m_pending > 0)
+        if (!m_pool.run_one())
+            m_pool.wait_progress([this]() { return 0 == m_pending; });
+
+    if (m_exception) {
+        std::exception_ptr x = m_exception;
+        m_exception = nullptr;
+        std::rethrow_exception(x);
+    }
+}
+
+
+task_group::~task_group() {
+    while (m_pending > 0)
+        if (!m_pool.run_one())
+            m_pool.wait_progress([this]() { return 0 == m_pending; });
+}
+
+}}  // end of namespaces parallel algorithm
@@ -0,0 +1,207 @@
+#ifndef algorithm__parallel__thread_pool_hxx
+#define algorithm__parallel__thread_pool_hxx
+
+/**
+ *  \file
+ *  \brief  Work-stealing thread pool
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <functional>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <exception>
+
+
+namespace algorithm {
+namespace parallel {
+
+/**
+ *  \brief  Work-stealing thread pool
+ *
+ *  Each worker has its own task deque; tasks submitted by a worker
+ *  are pushed to (and popped from) the back of its deque, idle workers
+ *  steal tasks from the front of the others' deques.
+ *  Tasks submitted by other threads go to a shared deque.
+ *
+ *  Threads waiting for tasks' completion should help executing
+ *  pending tasks (see \ref run_one and \ref task_group) so that nested
+ *  fork-join parallelism doesn't deadlock.
+ *
+ *  Tasks must not throw (use \ref task_group to propagate exceptions).
+ */
+class thread_pool {
+    public:
+
+    typedef std::function<void ()> task_t;  /**< Task */
+
+    private:
+
+    /** Task deque */
+    struct deque {
+        std::mutex         mutex;  /**< Deque mutex */
+        std::deque<task_t> tasks;  /**< Tasks       */
+    };  // end of struct deque
+
+    std::vector<std::unique_ptr<deque> > m_deques;   /**< Workers' + shared */
+    std::vector<std::thread>             m_workers;  /**< Worker threads    */
+    std::atomic<size_t>                  m_pending;  /**< Queued tasks      */
+    std::mutex                           m_mutex;    /**< Idle mutex        */
+    std::condition_variable              m_idle;     /**< Idle condition    */
+    std::condition_variable              m_progress; /**< Waiters' cond.    */
+    size_t                               m_waiters;  /**< Blocked waiters   */
+    bool                                 m_stop;     /**< Shutdown flag     */
+
+    static thread_local thread_pool * s_pool;   /**< Current worker's pool  */
+    static thread_local size_t        s_index;  /**< Current worker's index */
+
+    /**
+     *  \brief  Get task to execute
+     *
+     *  Tries own deque's back first, then steals from other deques' fronts.
+     *
+     *  \param  index  Deque index to start with
+     *  \param  task   Task
+     *
+     *  \return \c true iff a task was obtained
+     */
+    bool get(size_t index, task_t & task);
+
+    /** Worker routine */
+    void worker(size_t index);
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  threads  Number of worker threads (0 means number of CPUs)
+     */
+    explicit thread_pool(size_t threads = 0);
+
+    /** Number of worker threads */
+    size_t size() const { return m_workers.size(); }
+
+    /**
+     *  \brief  Submit task
+     *
+     *  \param  task  Task
+     */
+    void submit(task_t task);
+
+    /**
+     *  \brief  Execute a pending task in the calling thread (if any)
+     *
+     *  \return \c true iff a task was executed
+     */
+    bool run_one();
+
+    /**
+     *  \brief  Block until a task is queued or \c done holds
+     *
+     *  For threads waiting for tasks' completion that have no task
+     *  to help with.  Whoever makes \c done hold must call
+     *  \ref notify_progress afterwards.
+     *
+     *  \param  done  Completion predicate
+     */
+    template <class Pred>
+    void wait_progress(Pred done) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_waiters;
+        m_progress.wait(lock, [&]() { return m_pending > 0 || done(); });
+        --m_waiters;
+    }
+
+    /** Wake up threads blocked in \ref wait_progress */
+    void notify_progress();
+
+    /** Destructor (finishes pending tasks) */
+    ~thread_pool();
+
+};  // end of class thread_pool
+
+
+/**
+ *  \brief  Fork-join task group
+ *
+ *  Tasks are run by the pool; \ref wait helps executing pending tasks
+ *  until all the group's tasks are done (blocking while there's none).
+ *  Exception thrown by a task is re-thrown by \ref wait.
+ */
+class task_group {
+    private:
+
+    thread_pool        & m_pool;       /**< Thread pool      */
+    std::atomic<size_t>  m_pending;    /**< Unfinished tasks */
+    std::mutex           m_mutex;      /**< Exception mutex  */
+    std::exception_ptr   m_exception;  /**< 1st exception    */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  pool  Thread pool
+     */
+    task_group(thread_pool & pool): m_pool(pool), m_pending(0) {}
+
+    /**
+     *  \brief  Run task
+     *
+     *  \param  task  Task
+     */
+    void run(thread_pool::task_t task);
+
+    /** Wait for all the tasks' completion */
+    void wait();
+
+    /** Destructor (waits for the tasks) */
+    ~task_group();
+
+};  // end of class task_group
+
+}}  // end of namespaces parallel algorithm
+
+#endif  // end of #ifndef algorithm__parallel__thread_pool_hxx
@@ -0,0 +1,286 @@
+/**
+ *  \file
+ *  \brief  BK-tree: Levenshtein distance fuzzy search index
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/string/bk_tree.hxx"
+#include "algorithm/string/levenshtein.hxx"
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+
+
+namespace algorithm {
+namespace string {
+
+namespace impl {
+
+/** Serialised BK-tree signature */
+static const char bk_tree_magic[8] = { 'B', 'K', 'T', 'R', 'E', 'E', '0', '1' };
+
+/** Write 64 bit integer */
+static void bk_tree_write(std::ostream & out, uint64_t n) {
+    out.write((const char *)&n, sizeof(n));
+}
+
+/** Read 64 bit integer */
+static uint64_t bk_tree_read(std::istream & in) {
+    uint64_t n;
+    if (!in.read((char *)&n, sizeof(n)))
+        throw std::runtime_error("BK-tree: unexpected end of input");
+
+    return n;
+}
+
+}  // end of namespace impl
+
+
+bk_tree::bk_tree(const std::vector<std::string> & dict) {
+    m_nodes.reserve(dict.size());
+    for (const auto & word: dict) insert(word);
+}
+
+
+void bk_tree::add(const std::string & word, size_t parent, size_t dist) {
+    const size_t index = m_nodes.size();
+    m_nodes.emplace_back(word, parent, dist);
+
+    if (npos == parent) return;  // root
+
+    node & p = m_nodes[parent];
+    m_nodes[index].sibling = p.child;
+    p.child = index;
+    if (dist > p.max_dist) p.max_dist = dist;
+}
+
+
+bool bk_tree::insert(const std::string & word) {
+    if (m_nodes.empty()) {
+        add(word, npos, 0);
+        return true;
+    }
+
+    for (size_t n = 0; ;) {
+        const size_t dist = levenshtein_dist(word, m_nodes[n].word);
+        if (0 == dist) return false;  // already present
+
+        // Descend to child in the same distance
+        size_t child = m_nodes[n].child;
+        while (npos != child && m_nodes[child].dist != dist)
+            child = m_nodes[child].sibling;
+
+        if (npos == child) {
+            add(word, n, dist);
+            return true;
+        }
+
+        n = child;
+    }
+}
+
+
+bk_tree::matches_t bk_tree::find(const std::string & query, size_t max_k)
+const {
+    matches_t matches;
+    if (m_nodes.empty()) return matches;
+
+    std::vector<size_t> stack(1, 0);
+    while (!stack.empty()) {
+        const node & n = m_nodes[stack.back()];
+        const size_t index = stack.back();
+        stack.pop_back();
+
+        // Beyond the bound, neither the node nor its children match
+        const size_t bound = max_k + n.max_dist;
+        const size_t dist  = levenshtein_dist(query, n.word, bound);
+        if (dist > bound) continue;
+
+        if (dist <= max_k) matches.emplace_back(index, dist);
+
+        // Children in distance from [dist - max_k, dist + max_k]
+        for (size_t c = n.child; npos != c; c = m_nodes[c].sibling) {
+            const size_t d = m_nodes[c].dist;
+            if (d + max_k >= dist && d <= dist + max_k) stack.push_back(c);
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(),
+        [](const match_t & a, const match_t & b) {
+            return a.second < b.second ||
+                (a.second == b.second && a.first < b.first);
+        });
+
+    return matches;
+}
+
+
+bk_tree::matches_t bk_tree::nearest(const std::string & query, size_t n)
+const {
+    matches_t matches;
+    if (m_nodes.empty() || 0 == n) return matches;
+
+    // Best matches so far (max-heap by distance, then index)
+    auto worse = [](const match_t & a, const match_t & b) {
+        return a.second < b.second ||
+            (a.second == b.second && a.first < b.first);
+    };
+    std::priority_queue<match_t, std::vector<match_t>, decltype(worse)>
+        best(worse);
+
+    // Nodes to visit (min-heap by distance lower bound)
+    typedef std::pair<size_t, size_t> visit_t;  // (lower bound, node)
+    std::priority_queue<visit_t, std::vector<visit_t>,
+        std::greater<visit_t> > visit;
+    visit.emplace(0, 0);
+
+    while (!visit.empty()) {
+        const size_t bound = visit.top().first;
+        const size_t index = visit.top().second;
+        visit.pop();
+
+        const bool   full = best.size() == n;
+        const size_t tau  = full ? best.top().second : (size_t)-1;
+
+        if (full && bound > tau) break;  // nothing closer left
+
+        // Beyond the threshold, neither the node nor its children qualify
+        const node & nd = m_nodes[index];
+        size_t dist;
+        if (full) {
+            const size_t max_k = tau + nd.max_dist;
+            dist = levenshtein_dist(query, nd.word, max_k);
+            if (dist > max_k) continue;
+        }
+        else
+            dist = levenshtein_dist(query, nd.word);
+
+        const match_t match(index, dist);
+        if (!full)
+            best.push(match);
+        else if (worse(match, best.top())) {
+            best.pop();
+            best.push(match);
+        }
+
+        const bool   full_now = best.size() == n;
+        const size_t tau_now  = full_now ? best.top().second : (size_t)-1;
+
+        for (size_t c = nd.child; npos != c; c = m_nodes[c].sibling) {
+            const size_t d  = m_nodes[c].dist;
+            const size_t lb = d < dist ? dist - d : d - dist;
+
+            if (!(full_now && lb > tau_now)) visit.emplace(lb, c);
+        }
+    }
+
+    matches.resize(best.size());
+    for (size_t i = matches.size(); i > 0; --i) {
+        matches[i - 1] = best.top();
+        best.pop();
+    }
+
+    return matches;
+}
+
+
+void bk_tree::save(std::ostream & out) const {
+    out.write(impl::bk_tree_magic, sizeof(impl::bk_tree_magic));
+    impl::bk_tree_write(out, m_nodes.size());
+
+    for (const auto & n: m_nodes) {
+        impl::bk_tree_write(out, n.parent);
+        impl::bk_tree_write(out, n.dist);
+        impl::bk_tree_write(out, n.word.size());
+        out.write(n.word.data(), n.word.size());
+    }
+
+    if (!out) throw std::runtime_error("BK-tree: write failed");
+}
+
+
+void bk_tree::load(std::istream & in) {
+    char magic[sizeof(impl::bk_tree_magic)];
+    if (!in.read(magic, sizeof(magic)) ||
+        0 != ::memcmp(magic, impl::bk_tree_magic, sizeof(magic)))
+    {
+        throw std::runtime_error("BK-tree: invalid format");
+    }
+
+    const size_t size = impl::bk_tree_read(in);
+
+    std::vector<node> nodes;
+    m_nodes.swap(nodes);
+
+    std::string word;
+    for (size_t i = 0; i < size; ++i) {
+        const size_t parent = impl::bk_tree_read(in);
+        const size_t dist   = impl::bk_tree_read(in);
+        const size_t len    = impl::bk_tree_read(in);
+
+        // Parents precede their children
+        if ((0 == i) != (npos == parent) || (npos != parent && parent >= i))
+            throw std::runtime_error("BK-tree: invalid structure");
+
+        word.resize(len);
+        if (len && !in.read(&word[0], len))
+            throw std::runtime_error("BK-tree: unexpected end of input");
+
+        add(word, parent, dist);
+    }
+}
+
+
+bool bk_tree::is_saved(std::istream & in) {
+    const std::istream::pos_type pos = in.tellg();
+
+    char magic[sizeof(impl::bk_tree_magic)];
+    const bool saved = in.read(magic, sizeof(magic)) &&
+        0 == ::memcmp(magic, impl::bk_tree_magic, sizeof(magic));
+
+    in.clear();
+    in.seekg(pos);
+
+    return saved;
+}
+
+}}  // end of namespaces string algorithm
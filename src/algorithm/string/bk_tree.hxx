@@ -0,0 +1,200 @@
+#ifndef algorithm__string__bk_tree_hxx
+#define algorithm__string__bk_tree_hxx
+
+/**
+ *  \file
+ *  \brief  BK-tree: Levenshtein distance fuzzy search index
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  BK-tree (Burkhard-Keller tree)
+ *
+ *  Metric tree over Levenshtein distance.  Each node's children are keyed
+ *  by their distance from the node; by the triangle inequality, only
+ *  children with key in [d - k, d + k] (where d is the query distance from
+ *  the node) may contain words within distance k from the query.
+ *
+ *  See https://en.wikipedia.org/wiki/BK-tree
+ *
+ *  The words are identified by their insertion order index.
+ *  Duplicate words are stored once.
+ */
+class bk_tree {
+    public:
+
+    /** Match: word index and its distance from the query */
+    typedef std::pair<size_t, size_t> match_t;
+
+    /** Matches (sorted by distance, then word index) */
+    typedef std::vector<match_t> matches_t;
+
+    private:
+
+    static constexpr size_t npos = (size_t)-1;  /**< No node */
+
+    /** Tree node */
+    struct node {
+        std::string word;      /**< Word                              */
+        size_t      parent;    /**< Parent node                       */
+        size_t      dist;      /**< Distance from parent              */
+        size_t      child;     /**< First child                       */
+        size_t      sibling;   /**< Next sibling                      */
+        size_t      max_dist;  /**< Max. distance of children from us */
+
+        node(const std::string & w, size_t p, size_t d):
+            word(w), parent(p), dist(d),
+            child(npos), sibling(npos), max_dist(0)
+        {}
+    };  // end of struct node
+
+    std::vector<node> m_nodes;  /**< Nodes (root first) */
+
+    /**
+     *  \brief  Add node
+     *
+     *  \param  word    Word
+     *  \param  parent  Parent node
+     *  \param  dist    Distance from parent
+     */
+    void add(const std::string & word, size_t parent, size_t dist);
+
+    public:
+
+    /** Constructor (empty tree) */
+    bk_tree() {}
+
+    /**
+     *  \brief  Constructor (dictionary index)
+     *
+     *  \param  dict  Dictionary
+     */
+    explicit bk_tree(const std::vector<std::string> & dict);
+
+    /** Number of (distinct) words */
+    size_t size() const { return m_nodes.size(); }
+
+    /**
+     *  \brief  Word
+     *
+     *  \param  index  Word index
+     *
+     *  \return Word
+     */
+    const std::string & word(size_t index) const {
+        return m_nodes[index].word;
+    }
+
+    /**
+     *  \brief  Insert word
+     *
+     *  \param  word  Word
+     *
+     *  \return \c true iff the word was inserted (i.e. wasn't present)
+     */
+    bool insert(const std::string & word);
+
+    /**
+     *  \brief  Range query
+     *
+     *  \param  query  Query
+     *  \param  max_k  Max. distance
+     *
+     *  \return Words within \c max_k edits from \c query
+     */
+    matches_t find(const std::string & query, size_t max_k) const;
+
+    /**
+     *  \brief  Nearest neighbours query
+     *
+     *  The tree is searched best-first; subtrees which can't contain
+     *  a word closer than the current n-th best one are pruned.
+     *
+     *  \param  query  Query
+     *  \param  n      Number of neighbours
+     *
+     *  \return \c n (at most) nearest words
+     */
+    matches_t nearest(const std::string & query, size_t n) const;
+
+    /**
+     *  \brief  Serialise the tree
+     *
+     *  Binary format (host byte order): magic, number of nodes and nodes
+     *  (parent index, distance from parent, word length and word) in index
+     *  order.
+     *
+     *  \param  out  Output stream
+     */
+    void save(std::ostream & out) const;
+
+    /**
+     *  \brief  Deserialise tree
+     *
+     *  Throws an exception on format error.
+     *
+     *  \param  in  Input stream
+     */
+    void load(std::istream & in);
+
+    /**
+     *  \brief  Check serialised tree format signature
+     *
+     *  Doesn't consume the stream.
+     *
+     *  \param  in  Input stream
+     *
+     *  \return \c true iff the stream seems to contain serialised tree
+     */
+    static bool is_saved(std::istream & in);
+
+};  // end of class bk_tree
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__bk_tree_hxx
@@ -0,0 +1,180 @@
+#ifndef algorithm__string__edit_script_hxx
+#define algorithm__string__edit_script_hxx
+
+/**
+ *  \file
+ *  \brief  Run-length encoded edit script (CIGAR) alignment outputs
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  Alignment output: run-length encoded edit script
+ *
+ *  Keeps the alignment as runs of operations (extended CIGAR):
+ *  \c '=' (match), \c 'X' (substitution), \c 'D' (deletion, 1st string
+ *  character against gap) and \c 'I' (insertion, gap against 2nd string
+ *  character).  The memory used is proportional to the number of runs,
+ *  not to the alignment length.
+ */
+class edit_script {
+    public:
+
+    /** Run of operations */
+    struct run {
+        char   op;      /**< Operation ('=', 'X', 'D' or 'I') */
+        size_t length;  /**< Run length                        */
+    };  // end of struct run
+
+    typedef std::vector<run> runs_t;  /**< Runs */
+
+    private:
+
+    runs_t m_runs;  /**< Runs */
+
+    /** Append operation */
+    void push(char op) {
+        if (!m_runs.empty() && m_runs.back().op == op)
+            ++m_runs.back().length;
+        else
+            m_runs.push_back(run{op, 1});
+    }
+
+    public:
+
+    /** Aligned characters */
+    void sub(char c1, char c2) { push(c1 == c2 ? '=' : 'X'); }
+
+    /** Deletion (1st string character against gap) */
+    void del(char) { push('D'); }
+
+    /** Insertion (gap against 2nd string character) */
+    void ins(char) { push('I'); }
+
+    /** Runs */
+    const runs_t & runs() const { return m_runs; }
+
+    /** Number of edits (substitutions, deletions and insertions) */
+    size_t edits() const {
+        size_t edits = 0;
+        for (const auto & r: m_runs)
+            if ('=' != r.op) edits += r.length;
+
+        return edits;
+    }
+
+    /** CIGAR string (e.g. "3=1X2D4=") */
+    std::string str() const {
+        std::string cigar;
+        for (const auto & r: m_runs) {
+            cigar += std::to_string(r.length);
+            cigar += r.op;
+        }
+
+        return cigar;
+    }
+
+};  // end of class edit_script
+
+
+/**
+ *  \brief  Alignment output: streamed edit script
+ *
+ *  Writes the edit script (see \ref edit_script) to a stream as soon as
+ *  each run is complete, so that nothing but the current run is kept.
+ *  \ref flush must be called at the end of the alignment.
+ */
+class edit_script_stream {
+    private:
+
+    std::ostream & m_out;     /**< Output stream       */
+    char           m_op;      /**< Current run operation */
+    size_t         m_length;  /**< Current run length    */
+
+    /** Append operation */
+    void push(char op) {
+        if (op != m_op) {
+            flush();
+            m_op = op;
+        }
+
+        ++m_length;
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  out  Output stream
+     */
+    edit_script_stream(std::ostream & out):
+        m_out(out),
+        m_op('\0'),
+        m_length(0)
+    {}
+
+    /** Aligned characters */
+    void sub(char c1, char c2) { push(c1 == c2 ? '=' : 'X'); }
+
+    /** Deletion (1st string character against gap) */
+    void del(char) { push('D'); }
+
+    /** Insertion (gap against 2nd string character) */
+    void ins(char) { push('I'); }
+
+    /** Write the current run */
+    void flush() {
+        if (m_length) m_out << m_length << m_op;
+        m_length = 0;
+    }
+
+};  // end of class edit_script_stream
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__edit_script_hxx
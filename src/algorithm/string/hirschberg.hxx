@@ -42,9 +42,19 @@
  */
 
 
+#include "algorithm/string/nw_row.hxx"
+#include "algorithm/string/edit_script.hxx"
+#include "algorithm/string/stats.hxx"
+#include "algorithm/parallel/thread_pool.hxx"
+
 #include <string>
 #include <tuple>
-#include <memory>
+#include <ostream>
+#include <vector>
+#include <type_traits>
+#include <climits>
+
+#include <unistd.h>
 
 
 namespace algorithm {
@@ -64,11 +74,387 @@ inline T max(T a1, Ts... args) {
 };  // end of namespace impl
 
 
+/**
+ *  \brief  Constant cost function (char -> int)
+ *
+ *  Deletion/insertion cost model independent of the character.
+ *  Recognised by \ref hirschberg at compile time (fast path).
+ */
+class const_cost {
+    private:
+
+    int m_cost;  /**< Cost */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  cost  Cost
+     */
+    const_cost(int cost): m_cost(cost) {}
+
+    /** Cost getter */
+    int cost() const { return m_cost; }
+
+    /** Cost function */
+    int operator () (char) const { return m_cost; }
+
+};  // end of class const_cost
+
+
+/**
+ *  \brief  Match/mismatch cost function (char, char -> int)
+ *
+ *  Substitution cost model distinguishing only match and mismatch.
+ *  Recognised by \ref hirschberg at compile time (fast path).
+ */
+class match_cost {
+    private:
+
+    int m_eql;  /**< Character match cost */
+    int m_sub;  /**< Substitution cost    */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  eql  Character match cost
+     *  \param  sub  Substitution cost
+     */
+    match_cost(int eql, int sub): m_eql(eql), m_sub(sub) {}
+
+    /** Character match cost getter */
+    int eql() const { return m_eql; }
+
+    /** Substitution cost getter */
+    int sub() const { return m_sub; }
+
+    /** Cost function */
+    int operator () (char a, char b) const { return a == b ? m_eql : m_sub; }
+
+};  // end of class match_cost
+
+
+namespace impl {
+
+/**
+ *  \brief  Constant costs detection
+ *
+ *  \c value is \c true iff the cost function types allow for
+ *  the (vectorised) constant costs Needleman-Wunsch row kernel.
+ */
+template <class Del, class Ins, class Sub>
+struct is_const_cost: std::integral_constant<bool,
+    std::is_same<Del, const_cost>::value &&
+    std::is_same<Ins, const_cost>::value &&
+    std::is_same<Sub, match_cost>::value>
+{};
+
+/**
+ *  \brief  Max. costs (generic cost functions)
+ *
+ *  \param  del      Deletion cost function
+ *  \param  ins      Insertion cost function
+ *  \param  sub      Substitution cost function
+ *  \param  del_max  Max. deletion cost
+ *  \param  ins_max  Max. insertion cost
+ *  \param  sub_max  Max. substitution cost
+ */
+template <class Del, class Ins, class Sub>
+void max_costs(
+    Del & del, Ins & ins, Sub & sub,
+    int & del_max, int & ins_max, int & sub_max,
+    std::false_type)
+{
+    del_max = del(CHAR_MIN);
+    ins_max = ins(CHAR_MIN);
+    sub_max = sub(CHAR_MIN, CHAR_MIN);
+
+    for (int c1 = CHAR_MIN; c1 <= CHAR_MAX; ++c1) {
+        del_max = max(del_max, del((char)c1));
+        ins_max = max(ins_max, ins((char)c1));
+
+        for (int c2 = CHAR_MIN; c2 <= CHAR_MAX; ++c2)
+            sub_max = max(sub_max, sub((char)c1, (char)c2));
+    }
+}
+
+/** Max. costs (constant costs) */
+inline void max_costs(
+    const const_cost & del, const const_cost & ins, const match_cost & sub,
+    int & del_max, int & ins_max, int & sub_max,
+    std::true_type)
+{
+    del_max = del.cost();
+    ins_max = ins.cost();
+    sub_max = max(sub.eql(), sub.sub());
+}
+
+/**
+ *  \brief  Band of a score matrix row
+ *
+ *  Cell (i, j) of the |s1| x |s2| score matrix is within the band iff
+ *
+ *    |j * |s1| - i * |s2|| <= band * max(|s1|, |s2|)
+ *
+ *  i.e. it's at most \c band cells (along the longer string) from
+ *  the diagonal scaled to the matrix proportions.  Both the matrix
+ *  corners are within the band, and so is a path connecting them.
+ *  The band is symmetric with respect to reversal of both strings,
+ *  so it's the same for the forward and reverse sweeps.
+ *
+ *  \param  i        Row
+ *  \param  s1_size  Length of a string
+ *  \param  s2_size  Length of another string
+ *  \param  band     Band width (0 means unbanded)
+ *  \param  lo       First column within the band
+ *  \param  hi       Last column within the band
+ */
+inline void band_row(
+    size_t i, size_t s1_size, size_t s2_size, size_t band,
+    size_t & lo, size_t & hi)
+{
+    if (0 == band) {
+        lo = 0;
+        hi = s2_size;
+        return;
+    }
+
+    const size_t diag  = i * s2_size;
+    const size_t width = band * impl::max(s1_size, s2_size);
+
+    lo = diag > width ? (diag - width + s1_size - 1) / s1_size : 0;
+    hi = (diag + width) / s1_size;
+    if (hi > s2_size) hi = s2_size;
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Hirschberg's algorithm workspace
+ *
+ *  Keeps the score buffer, so that it may be reused by subsequent
+ *  alignments.  Not thread-safe; use one workspace per thread.
+ */
+class hirschberg_workspace {
+    private:
+
+    std::vector<int> m_scores;  /**< Score buffer */
+
+    public:
+
+    /**
+     *  \brief  Score buffer (grows if necessary)
+     *
+     *  \param  size  Required number of scores
+     *
+     *  \return Score buffer
+     */
+    int * scores(size_t size) {
+        if (m_scores.size() < size) {
+            m_scores.resize(size);
+            ALGORITHM_STATS_ADD(bytes, size * sizeof(int));
+        }
+
+        return m_scores.data();
+    }
+
+};  // end of class hirschberg_workspace
+
+
+/**
+ *  \brief  Alignment output: gap-padded strings
+ *
+ *  Writes the aligned strings (gaps as '-') to caller-provided buffers.
+ *  The buffers must be able to hold |s1| + |s2| characters.
+ */
+class padded_alignment {
+    private:
+
+    char * m_r1;    /**< Aligned 1st string */
+    char * m_r2;    /**< Aligned 2nd string */
+    size_t m_size;  /**< Alignment length   */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  r1  Aligned 1st string buffer
+     *  \param  r2  Aligned 2nd string buffer
+     */
+    padded_alignment(char * r1, char * r2):
+        m_r1(r1),
+        m_r2(r2),
+        m_size(0)
+    {}
+
+    /** Alignment length */
+    size_t size() const { return m_size; }
+
+    /** Aligned characters */
+    void sub(char c1, char c2) {
+        m_r1[m_size] = c1;
+        m_r2[m_size] = c2;
+        ++m_size;
+    }
+
+    /** Deletion (1st string character against gap) */
+    void del(char c1) { sub(c1, '-'); }
+
+    /** Insertion (gap against 2nd string character) */
+    void ins(char c2) { sub('-', c2); }
+
+};  // end of class padded_alignment
+
+
+/**
+ *  \brief  Alignment output: streamed gap-padded strings
+ *
+ *  Writes the aligned strings (gaps as '-') to a stream as they are
+ *  produced, in blocks of fixed width: the 1st string line, the 2nd
+ *  string line and an empty line.  Only the current block is kept,
+ *  so alignments of any length may be written.
+ *
+ *  \ref flush must be called at the end of the alignment.
+ */
+class padded_alignment_stream {
+    private:
+
+    std::ostream & m_out;    /**< Output stream       */
+    const size_t   m_width;  /**< Block width         */
+    std::string    m_r1;     /**< Aligned 1st string  */
+    std::string    m_r2;     /**< Aligned 2nd string  */
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  out    Output stream
+     *  \param  width  Block width (> 0)
+     */
+    padded_alignment_stream(std::ostream & out, size_t width = 60):
+        m_out(out),
+        m_width(width)
+    {
+        m_r1.reserve(width);
+        m_r2.reserve(width);
+    }
+
+    /** Aligned characters */
+    void sub(char c1, char c2) {
+        m_r1.push_back(c1);
+        m_r2.push_back(c2);
+
+        if (m_r1.size() >= m_width) flush();
+    }
+
+    /** Deletion (1st string character against gap) */
+    void del(char c1) { sub(c1, '-'); }
+
+    /** Insertion (gap against 2nd string character) */
+    void ins(char c2) { sub('-', c2); }
+
+    /** Write the current (incomplete) block */
+    void flush() {
+        if (m_r1.empty()) return;
+
+        m_out << m_r1 << '\n' << m_r2 << "\n\n";
+
+        m_r1.clear();
+        m_r2.clear();
+    }
+
+};  // end of class padded_alignment_stream
+
+
+namespace impl {
+
+/**
+ *  \brief  Alignment output buffer
+ *
+ *  Records alignment output operations so that they may be replayed
+ *  to another output later.
+ */
+class alignment_buffer {
+    private:
+
+    /** Operation */
+    struct op {
+        char code;  /**< 's', 'd' or 'i'    */
+        char c1;    /**< 1st string character */
+        char c2;    /**< 2nd string character */
+    };  // end of struct op
+
+    std::vector<op> m_ops;  /**< Operations */
+
+    public:
+
+    /** Aligned characters */
+    void sub(char c1, char c2) { m_ops.push_back(op{'s', c1, c2}); }
+
+    /** Deletion */
+    void del(char c1) { m_ops.push_back(op{'d', c1, '-'}); }
+
+    /** Insertion */
+    void ins(char c2) { m_ops.push_back(op{'i', '-', c2}); }
+
+    /**
+     *  \brief  Replay the operations
+     *
+     *  \param  out  Alignment output
+     */
+    template <class Output>
+    void replay(Output & out) const {
+        for (const auto & o: m_ops) {
+            switch (o.code) {
+                case 's': out.sub(o.c1, o.c2); break;
+                case 'd': out.del(o.c1);       break;
+                case 'i': out.ins(o.c2);       break;
+            }
+        }
+    }
+
+};  // end of class alignment_buffer
+
+
+/**
+ *  \brief  Number of scores fitting the CPU cache
+ *
+ *  Half of the L2 cache (256 KiB assumed if it can't be detected).
+ *
+ *  \return Number of scores
+ */
+inline size_t cache_scores() {
+    static const size_t scores = []() -> size_t {
+        long l2_size = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+        l2_size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        if (l2_size <= 0) l2_size = 256 * 1024;
+
+        return l2_size / 2 / sizeof(int);
+    }();
+
+    return scores;
+}
+
+}  // end of namespace impl
+
+
 /**
  *  \brief  Hirschberg's algorithm
  *
  *  See https://en.wikipedia.org/wiki/Hirschberg's_algorithm
  *
+ *  If \ref const_cost deletion/insertion and \ref match_cost substitution
+ *  cost functions are used, Needleman-Wunsch score rows are computed
+ *  by SIMD kernels (if supported by the CPU).
+ *
  *  \tparam  Del  Deletion cost function type (char -> int)
  *  \tparam  Ins  Insertion cost function type (char -> int)
  *  \tparam  Sub  Substitution const function type (char, char -> int)
@@ -81,204 +467,993 @@ class hirschberg {
     mutable Ins m_ins;  /**< Insertion const function   */
     mutable Sub m_sub;  /**< Substitution cost function */
 
-    public:
+    int m_del_max;  /**< Max. deletion cost     */
+    int m_ins_max;  /**< Max. insertion cost    */
+    int m_sub_max;  /**< Max. substitution cost */
+
+    size_t m_par_cutoff;  /**< Parallel computation cutoff */
+    size_t m_band;        /**< Band width (0 means unbanded) */
+    size_t m_leaf_cells;  /**< Full score matrix cutoff */
 
     /**
-     *  \brief  Constructor
+     *  \brief  Upper bound of alignment score
      *
-     *  \param  del  Deletion cost function
-     *  \param  ins  Insertion cost function
-     *  \param  sub  Substitution cost function
+     *  Any alignment of strings of the given lengths has k aligned
+     *  character pairs, |s1| - k deletions and |s2| - k insertions.
+     *  Bounding the costs by the max. ones, the score is linear in k,
+     *  so it's bounded by the score at either end of the k range.
+     *
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of another string
+     *
+     *  \return Upper bound of the strings alignment score
      */
-    hirschberg(Del del, Ins ins, Sub sub):
-        m_del(del),
-        m_ins(ins),
-        m_sub(sub)
-    {}
+    int score_bound(size_t s1_size, size_t s2_size) const {
+        const int k = (int)(s1_size < s2_size ? s1_size : s2_size);
 
-    typedef std::tuple<std::string, std::string> return_t;
+        return impl::max(
+            (int)s1_size * m_del_max + (int)s2_size * m_ins_max,
+            k * m_sub_max +
+            ((int)s1_size - k) * m_del_max + ((int)s2_size - k) * m_ins_max);
+    }
 
     /**
-     *  \brief  Implementation
+     *  \brief  Needleman-Wunsch score row (generic cost functions)
      *
-     *  \param  s1  A string
-     *  \param  s2  Another string
+     *  Computes row \c b of the Needleman-Wunsch score matrix from
+     *  the previous row \c a for character \c c.
+     *  \c b[0] must be set by the caller.
      *
-     *  \return String alignment
+     *  \tparam  Rev  Read \c s in reverse
+     *
+     *  \param  a  Previous row
+     *  \param  b  Computed row
+     *  \param  c  Character
+     *  \param  s  String
+     *  \param  n  Length of \c s
      */
-    return_t operator () (
-        const std::string & s1,
-        const std::string & s2)
+    template <bool Rev>
+    void nw_row(
+        const int * a, int * b, char c, const char * s, size_t n,
+        std::false_type)
     const {
-        const size_t s1_size = s1.size();
-        const size_t s2_size = s2.size();
+        for (size_t j = 0; j < n; ++j) {
+            const char s_j = Rev ? s[n - 1 - j] : s[j];
+
+            b[j + 1] = impl::max(
+                a[j]     + m_sub(c, s_j),
+                a[j + 1] + m_del(c),
+                b[j]     + m_ins(s_j));
+        }
+    }
+
+    /** Needleman-Wunsch score row (constant costs) */
+    template <bool Rev>
+    void nw_row(
+        const int * a, int * b, char c, const char * s, size_t n,
+        std::true_type)
+    const {
+        impl::nw_row<Rev>(a, b, c, s, n,
+            m_sub.eql(), m_sub.sub(), m_del.cost(), m_ins.cost());
+    }
+
+    /** Needleman-Wunsch score row */
+    template <bool Rev>
+    void nw_row(const int * a, int * b, char c, const char * s, size_t n)
+    const {
+        nw_row<Rev>(a, b, c, s, n, impl::is_const_cost<Del, Ins, Sub>());
+    }
+
+    /**
+     *  \brief  Alignment of a single character with a string
+     *
+     *  Needleman-Wunsch alignment for |s_1| == 1 (the recursion bottom).
+     *  The traceback merely finds position of the single character;
+     *  the alignment is then written in order.
+     *
+     *  \tparam  Swap    \c c_1 comes from the 2nd string
+     *  \tparam  Output  Alignment output type
+     *
+     *  \param  c_1       The character
+     *  \param  s_x       The string
+     *  \param  s_x_size  Length of \c s_x
+     *  \param  out       Alignment output
+     *  \param  buffer    Score buffer (at least 2 * (\c s_x_size + 1))
+     */
+    template <bool Swap, class Output>
+    void align_1(
+        char         c_1,
+        const char * s_x,
+        size_t       s_x_size,
+        Output     & out,
+        int        * buffer)
+    const {
+        // Costs of the character against gap, string characters against gap
+        // and substitution (with respect to the strings' roles)
+        auto gap_1 = [this](char c) -> int {
+            return Swap ? m_ins(c) : m_del(c);
+        };
+        auto gap_x = [this](char c) -> int {
+            return Swap ? m_del(c) : m_ins(c);
+        };
+        auto sub_1x = [this](char c1, char cx) -> int {
+            return Swap ? m_sub(cx, c1) : m_sub(c1, cx);
+        };
+
+        // Compute Needleman-Wunsch scores for |s_1| == 1
+        const int    gap_c_1         = gap_1(c_1);
+        const size_t s_x_size_plus_1 = s_x_size + 1;
+        int * nw_score_0 = buffer + 0 * (s_x_size_plus_1);
+        int * nw_score_1 = buffer + 1 * (s_x_size_plus_1);
+
+        nw_score_0[0] = 0;
+        nw_score_1[0] = 0 + gap_c_1;
+        for (size_t j = 0; j < s_x_size; ++j) {
+            nw_score_0[j + 1] = nw_score_0[j] + gap_x(s_x[j]);
+            nw_score_1[j + 1] = impl::max(
+                nw_score_0[j]     + sub_1x(c_1, s_x[j]),
+                nw_score_0[j + 1] + gap_c_1,
+                nw_score_1[j]     + gap_x(s_x[j]));
+        }
+
+        // Trace the character position back
+        size_t j = s_x_size;
+        bool   sub;
+        for (;; --j) {
+            // Substitution
+            if (j) {
+                sub = nw_score_1[j] ==
+                    nw_score_0[j - 1] + sub_1x(c_1, s_x[j - 1]);
+
+                if (sub) break;
+            }
 
+            // Deletion (always matches for j == 0)
+            sub = false;
+            if (nw_score_1[j] == nw_score_0[j] + gap_c_1) break;
+        }
+
+        // Write the alignment
+        const size_t pos = sub ? j - 1 : j;
+        for (size_t k = 0; k < pos; ++k) {
+            if (Swap) out.del(s_x[k]);
+            else      out.ins(s_x[k]);
+        }
+
+        if (sub) {
+            if (Swap) out.sub(s_x[pos], c_1);
+            else      out.sub(c_1, s_x[pos]);
+        }
+        else {
+            if (Swap) out.ins(c_1);
+            else      out.del(c_1);
+        }
+
+        for (size_t k = j; k < s_x_size; ++k) {
+            if (Swap) out.del(s_x[k]);
+            else      out.ins(s_x[k]);
+        }
+    }
+
+    /**
+     *  \brief  Trivial alignments (recursion bottom)
+     *
+     *  Handles empty strings and strings of length 1.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *
+     *  \return \c true iff the alignment was trivial (and is done)
+     */
+    template <class Output>
+    bool align_trivial(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        Output     & out,
+        int        * buffer)
+    const {
         // One of the strings is empty
-        if (0 == s1_size) return return_t(std::string(s2_size, '-'), s2);
-        if (0 == s2_size) return return_t(s1, std::string(s1_size, '-'));
+        if (0 == s1_size) {
+            for (size_t j = 0; j < s2_size; ++j) out.ins(s2[j]);
+            return true;
+        }
 
-        // Find string of length 1 (if any)
-        const std::string * s_1 = NULL;
-        const std::string * s_x;
+        if (0 == s2_size) {
+            for (size_t i = 0; i < s1_size; ++i) out.del(s1[i]);
+            return true;
+        }
 
+        // One of the strings has length 1
         if (1 == s1_size) {
-            s_1 = &s1;
-            s_x = &s2;
+            align_1<false>(s1[0], s2, s2_size, out, buffer);
+            return true;
         }
-        else if (1 == s2_size) {
-            s_1 = &s2;
-            s_x = &s1;
+
+        if (1 == s2_size) {
+            align_1<true>(s2[0], s1, s1_size, out, buffer);
+            return true;
         }
 
-        // One of the strings has length 1
-        if (NULL != s_1) {
-            // Compute Needleman-Wunsch scores for |s_1| == 1
-            const char   c_1             = s_1->at(0);
-            const int    m_del_c_1       = m_del(c_1);
-            const size_t s_x_size        = s_x->size();
-            const size_t s_x_size_plus_1 = s_x_size + 1;
-            std::unique_ptr<int> nw_scores(new int[2 * (s_x_size_plus_1)]);
-            int * nw_scores_ptr = nw_scores.get();
-            int * nw_score_0    = nw_scores_ptr + 0 * (s_x_size_plus_1);
-            int * nw_score_1    = nw_scores_ptr + 1 * (s_x_size_plus_1);
-
-            nw_score_0[0] = 0;
-            nw_score_1[0] = 0 + m_del(m_del_c_1);
-            for (size_t j = 0; j < s_x_size; ++j) {
-                nw_score_0[j + 1] = nw_score_0[j] + m_ins(s_x->at(j));
-                nw_score_1[j + 1] = impl::max(
-                    nw_score_0[j]     + m_sub(c_1, s_x->at(j)),
-                    nw_score_0[j + 1] + m_del_c_1,
-                    nw_score_1[j]     + m_ins(s_x->at(j)));
-            }
+        return false;
+    }
+
+    /**
+     *  \brief  Full score matrix alignment (recursion bottom)
+     *
+     *  Needleman-Wunsch alignment with traceback.  The score matrix
+     *  is computed for the strings' suffixes (i.e. by reverse sweep),
+     *  so that the traceback runs from the strings' beginning
+     *  and the alignment is written in order.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  buffer   Score buffer ((|s1| + 1) * (|s2| + 1) scores)
+     */
+    template <class Output>
+    void align_matrix(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        Output     & out,
+        int        * buffer)
+    const {
+        ALGORITHM_STATS_TIMER(LEAF);
+        ALGORITHM_STATS_ADD(cells, (s1_size + 1) * (s2_size + 1));
+
+        // Scores of s1 suffix of length i and s2 suffix of length j
+        const size_t row = s2_size + 1;
+        auto score = [buffer, row](size_t i, size_t j) -> int & {
+            return buffer[i * row + j];
+        };
 
-            // Compute Needleman-Wunsch aligment for |s_1| == 1
-            std::string r1; r1.reserve(s_x_size);
-            std::string r2; r2.reserve(s_x_size);
-
-            for (size_t i = 1, j = s_x_size; i | j; ) {
-                if (i) {
-                    int nw_score;
-
-                    if (j) {
-                        nw_score = nw_score_0[j - 1] +
-                            m_sub(c_1, s_x->at(j - 1));
-
-                        // Substitution
-                        if (nw_score_1[j] == nw_score) {
-                            r1.push_back(c_1);
-                            r2.push_back(s_x->at(j - 1));
-                            --i;
-                            --j;
-                            continue;
-                        }
-                    }
-
-                    nw_score = nw_score_0[j] + m_del_c_1;
-
-                    // Deletion
-                    if (nw_score_1[j] == nw_score) {
-                        r1.push_back(c_1);
-                        r2.push_back('-');
-                        --i;
-                        continue;
-                    }
-                }
-
-                // Insertion
-                r1.push_back('-');
-                r2.push_back(s_x->at(j - 1));
+        score(0, 0) = 0;
+        for (size_t j = 1; j <= s2_size; ++j)
+            score(0, j) = score(0, j - 1) + m_ins(s2[s2_size - j]);
+
+        for (size_t i = 1; i <= s1_size; ++i) {
+            const char c1 = s1[s1_size - i];
+
+            score(i, 0) = score(i - 1, 0) + m_del(c1);
+            nw_row<true>(&score(i - 1, 0), &score(i, 0), c1, s2, s2_size);
+        }
+
+        // Traceback (deletion preferred, then substitution)
+        size_t i = s1_size;
+        size_t j = s2_size;
+        while (i && j) {
+            const char c1 = s1[s1_size - i];
+            const char c2 = s2[s2_size - j];
+            const int  sc = score(i, j);
+
+            if (sc == score(i - 1, j) + m_del(c1)) {
+                out.del(c1);
+                --i;
+            }
+            else if (sc == score(i - 1, j - 1) + m_sub(c1, c2)) {
+                out.sub(c1, c2);
+                --i; --j;
+            }
+            else {
+                out.ins(c2);
                 --j;
             }
+        }
 
-            // Reverse output
-            for (size_t j = 0, k = r1.size() - 1; j < k; ++j, --k) {
-                auto c = r1[j];
-                r1[j] = r1[k];
-                r1[k] = c;
-                c = r2[j];
-                r2[j] = r2[k];
-                r2[k] = c;
-            }
+        for (; i; --i) out.del(s1[s1_size - i]);
+        for (; j; --j) out.ins(s2[s2_size - j]);
+    }
 
-            return 1 == s1_size ? return_t(r1, r2) : return_t(r2, r1);
+    /**
+     *  \brief  Upper bound of scores of paths leaving the band
+     *
+     *  Considers the paths which leave the band between rows \c i and
+     *  \c i + 1, i.e. enter a cell outside the band for the 1st time.
+     *  Up to that cell, such a path is within the band, so its score
+     *  is bounded by the (banded) score of the preceding cell plus
+     *  the step cost.  The rest of the path is bounded by \ref score_bound.
+     *
+     *  \tparam  Rev  Read \c s2 in reverse (reverse sweep)
+     *
+     *  \param  a        Row \c i scores
+     *  \param  b        Row \c i + 1 scores
+     *  \param  i        Row
+     *  \param  lo       First column of row \c i band
+     *  \param  hi       Last column of row \c i band
+     *  \param  lo_b     First column of row \c i + 1 band
+     *  \param  hi_b     Last column of row \c i + 1 band
+     *  \param  c        Row \c i + 1 character
+     *  \param  s2       Another string
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of \c s2
+     *
+     *  \return Upper bound of scores of the paths leaving the band
+     */
+    template <bool Rev>
+    int band_exit(
+        const int * a, const int * b, size_t i,
+        size_t lo, size_t hi, size_t lo_b, size_t hi_b,
+        char c, const char * s2, size_t s1_size, size_t s2_size)
+    const {
+        auto s2_j = [&](size_t j) {
+            return Rev ? s2[s2_size - 1 - j] : s2[j];
+        };
+
+        int bound = impl::nw_row_ninf;
+
+        // Right edge (insertion or match step)
+        if (hi_b < s2_size) {
+            int score = b[hi_b] + m_ins(s2_j(hi_b));
+            if (hi == hi_b)
+                score = impl::max(score, a[hi] + m_sub(c, s2_j(hi)));
+
+            bound = score + score_bound(s1_size - i - 1, s2_size - hi_b - 1);
         }
 
-        // Compute Needleman-Wunsch scores
-        size_t s1_div = s1_size / 2;
+        // Left edge (deletion or match step)
+        for (size_t j = lo; j < lo_b && j <= hi; ++j) {
+            int score = a[j] + m_del(c);
+            if (j > lo)
+                score = impl::max(score, a[j - 1] + m_sub(c, s2_j(j - 1)));
 
-        // Needleman-Wunsch score matrices' last 2 rows (for each side of s1)
-        const size_t s2_size_plus_1  = s2_size + 1;
-        const size_t s2_size_minus_1 = s2_size - 1;
-        std::unique_ptr<int> nw_score_buffer(new int[4 * (s2_size_plus_1)]);
-        int * nw_score_ptr = nw_score_buffer.get();
-        int * nw_score_a   = nw_score_ptr + 0 * s2_size_plus_1;
-        int * nw_score_b   = nw_score_ptr + 1 * s2_size_plus_1;
-        int * nw_score_x   = nw_score_ptr + 2 * s2_size_plus_1;
-        int * nw_score_y   = nw_score_ptr + 3 * s2_size_plus_1;
-
-        // Initialise 1st rows
+            bound = impl::max(bound,
+                score + score_bound(s1_size - i - 1, s2_size - j));
+        }
+
+        return bound;
+    }
+
+    /**
+     *  \brief  Needleman-Wunsch scores of \c s1 prefix (forward sweep)
+     *
+     *  Only the cells within the band are computed (see \ref impl::band_row);
+     *  the cells next to the band are set to -infinity.
+     *  Upper bound of scores of paths leaving the band (in the computed
+     *  rows) is computed, too (see \ref band_exit).
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s1_div   Length of \c s1 prefix
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  nw_score_a  Score row buffer
+     *  \param  nw_score_b  Another score row buffer
+     *  \param  exit     Band exit score bound
+     *
+     *  \return Last score row (one of the buffers)
+     */
+    const int * nw_forward(
+        const char * s1, size_t s1_size, size_t s1_div,
+        const char * s2, size_t s2_size,
+        size_t band,
+        int * nw_score_a, int * nw_score_b,
+        int & exit)
+    const {
+        ALGORITHM_STATS_TIMER(SWEEP);
+
+        size_t lo, hi;
+        impl::band_row(0, s1_size, s2_size, band, lo, hi);
+
+        // Initialise 1st row
         nw_score_a[0] = 0;
-        for (size_t j = 0; j < s2_size; ++j)
+        for (size_t j = 0; j < hi; ++j)
             nw_score_a[j + 1] = nw_score_a[j] + m_ins(s2[j]);
 
-        nw_score_x[0] = 0;
-        for (size_t j = 1; j <= s2_size; ++j)
-            nw_score_x[j] = nw_score_x[j - 1] + m_ins(s2[s2_size - j]);
+        exit = hi < s2_size
+            ? nw_score_a[hi] + m_ins(s2[hi]) +
+              score_bound(s1_size, s2_size - hi - 1)
+            : impl::nw_row_ninf;
+
+        // Compute the matrix' other rows (keeping only the last 2 at a time)
+        for (size_t i = 0; i < s1_div; ++i) {
+            size_t lo_b, hi_b;
+            impl::band_row(i + 1, s1_size, s2_size, band, lo_b, hi_b);
+            ALGORITHM_STATS_ADD(cells, hi_b + 1 - lo_b);
+
+            for (size_t j = hi + 1; j <= hi_b; ++j)
+                nw_score_a[j] = impl::nw_row_ninf;
 
-        // Compute the matrices' other rows (keeping only the last 2 at a time)
-        for (size_t i = 0, k = s1_size - 1; i < s1_div; ++i, --k) {
-            nw_score_b[0] = nw_score_a[0] + m_del(s1[i]);
-            nw_score_y[0] = nw_score_x[0] + m_del(s1[k]);
-
-            for (size_t j = 0, l = s2_size_minus_1; j < s2_size; ++j, --l) {
-                nw_score_b[j + 1] = impl::max(
-                    nw_score_a[j]     + m_sub(s1[i], s2[j]),
-                    nw_score_a[j + 1] + m_del(s1[i]),
-                    nw_score_b[j]     + m_ins(s2[j]));
-
-                nw_score_y[j + 1] = impl::max(
-                    nw_score_x[j]     + m_sub(s1[k], s2[l]),
-                    nw_score_x[j + 1] + m_del(s1[k]),
-                    nw_score_y[j]     + m_ins(s2[l]));
+            if (0 == lo_b) {
+                nw_score_b[0] = nw_score_a[0] + m_del(s1[i]);
+                nw_row<false>(nw_score_a, nw_score_b, s1[i], s2, hi_b);
             }
+            else {
+                const size_t j = lo_b - 1;
+
+                nw_score_b[j] = impl::nw_row_ninf;
+                nw_row<false>(nw_score_a + j, nw_score_b + j, s1[i],
+                    s2 + j, hi_b - j);
+            }
+
+            exit = impl::max(exit, band_exit<false>(nw_score_a, nw_score_b,
+                i, lo, hi, lo_b, hi_b, s1[i], s2, s1_size, s2_size));
 
-            // Swap Needleman-Wunsch score matrices' last 2 rows
             auto nw_score_t = nw_score_a;
             nw_score_a = nw_score_b;
             nw_score_b = nw_score_t;
-            nw_score_t = nw_score_x;
+
+            lo = lo_b;
+            hi = hi_b;
+        }
+
+        return nw_score_a;
+    }
+
+    /**
+     *  \brief  Needleman-Wunsch scores of \c s1 suffix (reverse sweep)
+     *
+     *  Only the cells within the band are computed, see \ref nw_forward.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s1_div   Start of \c s1 suffix
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  nw_score_x  Score row buffer
+     *  \param  nw_score_y  Another score row buffer
+     *  \param  exit     Band exit score bound
+     *
+     *  \return Last score row (one of the buffers)
+     */
+    const int * nw_reverse(
+        const char * s1, size_t s1_size, size_t s1_div,
+        const char * s2, size_t s2_size,
+        size_t band,
+        int * nw_score_x, int * nw_score_y,
+        int & exit)
+    const {
+        ALGORITHM_STATS_TIMER(SWEEP);
+
+        size_t lo, hi;
+        impl::band_row(0, s1_size, s2_size, band, lo, hi);
+
+        // Initialise 1st row
+        nw_score_x[0] = 0;
+        for (size_t j = 1; j <= hi; ++j)
+            nw_score_x[j] = nw_score_x[j - 1] + m_ins(s2[s2_size - j]);
+
+        exit = hi < s2_size
+            ? nw_score_x[hi] + m_ins(s2[s2_size - 1 - hi]) +
+              score_bound(s1_size, s2_size - hi - 1)
+            : impl::nw_row_ninf;
+
+        // Compute the matrix' other rows (keeping only the last 2 at a time)
+        for (size_t k = s1_size; k > s1_div; ) {
+            --k;
+
+            size_t lo_y, hi_y;
+            impl::band_row(s1_size - k, s1_size, s2_size, band, lo_y, hi_y);
+            ALGORITHM_STATS_ADD(cells, hi_y + 1 - lo_y);
+
+            for (size_t j = hi + 1; j <= hi_y; ++j)
+                nw_score_x[j] = impl::nw_row_ninf;
+
+            // Note that the band's end is the reversed s2 suffix start
+            const char * s2_rev = s2 + s2_size - hi_y;
+
+            if (0 == lo_y) {
+                nw_score_y[0] = nw_score_x[0] + m_del(s1[k]);
+                nw_row<true>(nw_score_x, nw_score_y, s1[k], s2_rev, hi_y);
+            }
+            else {
+                const size_t j = lo_y - 1;
+
+                nw_score_y[j] = impl::nw_row_ninf;
+                nw_row<true>(nw_score_x + j, nw_score_y + j, s1[k],
+                    s2_rev, hi_y - j);
+            }
+
+            exit = impl::max(exit, band_exit<true>(nw_score_x, nw_score_y,
+                s1_size - 1 - k, lo, hi, lo_y, hi_y, s1[k], s2,
+                s1_size, s2_size));
+
+            auto nw_score_t = nw_score_x;
             nw_score_x = nw_score_y;
             nw_score_y = nw_score_t;
+
+            lo = lo_y;
+            hi = hi_y;
         }
 
-        // In case of odd s1 size, we must add one more iteration (right)
-        if (s1_size % 2) {
-            for (size_t j = 0, l = s2_size_minus_1; j < s2_size; ++j, --l)
-                nw_score_y[j + 1] = impl::max(
-                    nw_score_x[j]     + m_sub(s1[s1_div], s2[l]),
-                    nw_score_x[j + 1] + m_del(s1[s1_div]),
-                    nw_score_y[j]     + m_ins(s2[l]));
+        return nw_score_x;
+    }
 
-            // Final swap (no need to access the prev. row any longer)
-            nw_score_x = nw_score_y;
+    /**
+     *  \brief  Find (locally) optimal \c s2 division
+     *
+     *  The forward and reverse sweeps are independent; if a thread pool
+     *  is provided, they run concurrently.
+     *
+     *  If banded, the division is searched for within the band only.
+     *  If a path leaving the band may score better than the best one
+     *  within the band (see \ref band_exit), the optimal alignment may
+     *  leave the band; the band width is doubled and the division is
+     *  searched for again.  The (possibly widened) band width is used
+     *  for the sub-problems.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool (optional)
+     *
+     *  \return \c s2 division for \c s1 division at |s1| / 2
+     */
+    size_t split(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        size_t     & band,
+        int        * buffer,
+        parallel::thread_pool * pool = NULL)
+    const {
+        const size_t s1_div = s1_size / 2;
+
+        for (;;) {
+            // Band covering the whole matrix
+            if (band >= s1_size || band >= s2_size) band = 0;
+
+            size_t lo, hi;
+            impl::band_row(s1_div, s1_size, s2_size, band, lo, hi);
+
+            bool optimal;
+            const size_t s2_div = split(
+                s1, s1_size, s2, s2_size, band, lo, hi, buffer, pool,
+                optimal);
+
+            if (optimal) return s2_div;
+
+            band *= 2;
+        }
+    }
+
+    /**
+     *  \brief  Find (locally) optimal \c s2 division within band
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  lo       First column of the band at |s1| / 2
+     *  \param  hi       Last column of the band at |s1| / 2
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool (optional)
+     *  \param  optimal  No path leaving the band scores better
+     *
+     *  \return \c s2 division for \c s1 division at |s1| / 2
+     */
+    size_t split(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        size_t       band,
+        size_t       lo,
+        size_t       hi,
+        int        * buffer,
+        parallel::thread_pool * pool,
+        bool       & optimal)
+    const {
+        const size_t s1_div = s1_size / 2;
+
+        // Needleman-Wunsch score matrices' last 2 rows (for each side of s1)
+        const size_t s2_size_plus_1 = s2_size + 1;
+        int * nw_score_a = buffer + 0 * s2_size_plus_1;
+        int * nw_score_b = buffer + 1 * s2_size_plus_1;
+        int * nw_score_x = buffer + 2 * s2_size_plus_1;
+        int * nw_score_y = buffer + 3 * s2_size_plus_1;
+
+        const int * nw_score_l;  // left  (forward) scores
+        const int * nw_score_r;  // right (reverse) scores
+        int         exit_l;      // left  band exit score bound
+        int         exit_r;      // right band exit score bound
+
+        if (NULL == pool) {
+            nw_score_l = nw_forward(s1, s1_size, s1_div, s2, s2_size,
+                band, nw_score_a, nw_score_b, exit_l);
+            nw_score_r = nw_reverse(s1, s1_size, s1_div, s2, s2_size,
+                band, nw_score_x, nw_score_y, exit_r);
+        }
+        else {
+            parallel::task_group sweeps(*pool);
+            sweeps.run([&]() {
+                nw_score_r = nw_reverse(s1, s1_size, s1_div, s2, s2_size,
+                    band, nw_score_x, nw_score_y, exit_r);
+            });
+
+            nw_score_l = nw_forward(s1, s1_size, s1_div, s2, s2_size,
+                band, nw_score_a, nw_score_b, exit_l);
+
+            sweeps.wait();
         }
 
         // Get (locally) optimal s2 division
-        size_t s2_div = 0;
-        for (size_t j = 0, l = s2_size; j <= s2_size; ++j, --l) {
-            nw_score_b[j] = nw_score_a[j] + nw_score_x[l];
+        size_t s2_div = lo;
+        int    s2_div_score = nw_score_l[lo] + nw_score_r[s2_size - lo];
+        for (size_t j = lo + 1, l = s2_size - j; j <= hi; ++j, --l) {
+            const int score = nw_score_l[j] + nw_score_r[l];
+
+            if (score > s2_div_score) {
+                s2_div       = j;
+                s2_div_score = score;
+            }
+        }
+
+        optimal = s2_div_score >= impl::max(exit_l, exit_r);
+
+        return s2_div;
+    }
+
+    /**
+     *  \brief  Implementation
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     */
+    template <class Output>
+    void align_impl(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        Output     & out,
+        size_t       band,
+        int        * buffer)
+    const {
+        ALGORITHM_STATS_CALL();
+
+        if (align_trivial(s1, s1_size, s2, s2_size, out, buffer)) return;
 
-            if (nw_score_b[j] > nw_score_b[s2_div]) s2_div = j;
+        // Small enough for full score matrix
+        if ((s1_size + 1) * (s2_size + 1) <= m_leaf_cells) {
+            align_matrix(s1, s1_size, s2, s2_size, out, buffer);
+            return;
         }
 
+        const size_t s1_div = s1_size / 2;
+        const size_t s2_div = split(s1, s1_size, s2, s2_size, band, buffer);
+
+        // Divide and conquer (the score buffer is free for reuse)
+        align_impl(s1, s1_div, s2, s2_div, out, band, buffer);
+        align_impl(
+            s1 + s1_div, s1_size - s1_div,
+            s2 + s2_div, s2_size - s2_div, out, band, buffer);
+    }
+
+    /**
+     *  \brief  Implementation (parallel)
+     *
+     *  Above the cutoff, the sweeps and both the halves are computed
+     *  concurrently.  The right half gets its own score buffer and its
+     *  alignment is buffered and written after the left one.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool
+     */
+    template <class Output>
+    void align_parallel(
+        const char            * s1, size_t s1_size,
+        const char            * s2, size_t s2_size,
+        Output                & out,
+        size_t                  band,
+        int                   * buffer,
+        parallel::thread_pool & pool)
+    const {
+        // Serial below cutoff (or full score matrix)
+        if (s1_size * s2_size < m_par_cutoff ||
+            (s1_size + 1) * (s2_size + 1) <= m_leaf_cells)
+        {
+            align_impl(s1, s1_size, s2, s2_size, out, band, buffer);
+            return;
+        }
+
+        ALGORITHM_STATS_CALL();
+
+        if (align_trivial(s1, s1_size, s2, s2_size, out, buffer)) return;
+
+        const size_t s1_div = s1_size / 2;
+        const size_t s2_div = split(
+            s1, s1_size, s2, s2_size, band, buffer, &pool);
+
         // Divide and conquer
-        auto left  = (*this)(s1.substr(0, s1_div),  s2.substr(0, s2_div));
-        auto right = (*this)(s1.substr(s1_div),     s2.substr(s2_div));
+        const char * s1_r      = s1 + s1_div;
+        const char * s2_r      = s2 + s2_div;
+        const size_t s1_r_size = s1_size - s1_div;
+        const size_t s2_r_size = s2_size - s2_div;
+
+        impl::alignment_buffer right;
+        parallel::task_group   halves(pool);
+        halves.run([&]() {
+            std::vector<int> right_buffer(
+                workspace_size(s1_r_size, s2_r_size));
+            ALGORITHM_STATS_ADD(bytes, right_buffer.size() * sizeof(int));
+
+            align_parallel(s1_r, s1_r_size, s2_r, s2_r_size,
+                right, band, right_buffer.data(), pool);
+        });
+
+        align_parallel(s1, s1_div, s2, s2_div, out, band, buffer, pool);
+
+        halves.wait();
+        right.replay(out);
+    }
+
+    /**
+     *  \brief  Padded strings alignment
+     *
+     *  \param  s1    A string
+     *  \param  s2    Another string
+     *  \param  ws    Workspace
+     *  \param  pool  Thread pool (optional)
+     *
+     *  \return String alignment
+     */
+    std::tuple<std::string, std::string> align_padded(
+        const std::string     & s1,
+        const std::string     & s2,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool * pool)
+    const {
+        const size_t s1_size = s1.size();
+        const size_t s2_size = s2.size();
+
+        // Alignment length is at most |s1| + |s2|
+        std::tuple<std::string, std::string> result;
+        std::string & r1 = std::get<0>(result);
+        std::string & r2 = std::get<1>(result);
+        r1.resize(s1_size + s2_size);
+        r2.resize(s1_size + s2_size);
+
+        padded_alignment out(&r1[0], &r2[0]);
+        if (NULL == pool)
+            align(s1.data(), s1_size, s2.data(), s2_size, out, ws);
+        else
+            align(s1.data(), s1_size, s2.data(), s2_size, out, ws, *pool);
+
+        r1.resize(out.size());
+        r2.resize(out.size());
+
+        return result;
+    }
+
+    public:
+
+    /** Default parallel computation cutoff (|s1| * |s2|) */
+    static constexpr size_t parallel_cutoff_dflt = 1 << 22;
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  del  Deletion cost function
+     *  \param  ins  Insertion cost function
+     *  \param  sub  Substitution cost function
+     */
+    hirschberg(Del del, Ins ins, Sub sub):
+        m_del(del),
+        m_ins(ins),
+        m_sub(sub),
+        m_par_cutoff(parallel_cutoff_dflt),
+        m_band(0),
+        m_leaf_cells(impl::cache_scores())
+    {
+        impl::max_costs(m_del, m_ins, m_sub, m_del_max, m_ins_max, m_sub_max,
+            impl::is_const_cost<Del, Ins, Sub>());
+    }
+
+    typedef std::tuple<std::string, std::string> return_t;
+
+    /**
+     *  \brief  Set parallel computation cutoff
+     *
+     *  Subproblems with |s1| * |s2| below the cutoff are computed serially.
+     *
+     *  \param  cutoff  Cutoff
+     */
+    void parallel_cutoff(size_t cutoff) { m_par_cutoff = cutoff; }
+
+    /**
+     *  \brief  Set band width (banded alignment)
+     *
+     *  For similar strings, the optimal alignment path stays close
+     *  to the score matrix diagonal.  If the band width is set, only
+     *  the score matrix cells at most \c band cells from the (scaled)
+     *  diagonal are computed at each recursion level, so the computation
+     *  time is O(n * band) per level instead of O(n^2).
+     *  Set the band width to the expected max. number of edits.
+     *
+     *  The band is widened automatically if an alignment leaving
+     *  the band might score better than the best one within it
+     *  (checked by an upper bound of the score, using the max. costs),
+     *  so the alignment is optimal regardless of the band width.
+     *  If the band covers the edits, it's rarely widened.
+     *  The memory used stays linear.
+     *
+     *  \param  band  Band width (0 means unbanded, which is the default)
+     */
+    void band(size_t band) { m_band = band; }
+
+    /**
+     *  \brief  Set full score matrix cutoff
+     *
+     *  Sub-problems with (|s1| + 1) * (|s2| + 1) up to the cutoff are
+     *  aligned using full Needleman-Wunsch score matrix with traceback
+     *  instead of further recursion.  By default, the cutoff is set so
+     *  that the matrix fits half of the CPU L2 cache.
+     *  The score buffer size is bounded by the cutoff, so the memory used
+     *  stays linear.
+     *
+     *  \param  cells  Cutoff (0 means that the recursion goes all the way
+     *                 down to single characters)
+     */
+    void leaf_cells(size_t cells) { m_leaf_cells = cells; }
+
+    /**
+     *  \brief  Score buffer size needed for strings alignment
+     *
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of another string
+     *
+     *  \return Number of scores
+     */
+    size_t workspace_size(size_t s1_size, size_t s2_size) const {
+        const size_t matrix = (s1_size + 1) * (s2_size + 1);
+
+        return impl::max(4 * (s2_size + 1), 2 * (s1_size + 1),
+            matrix < m_leaf_cells ? matrix : m_leaf_cells);
+    }
+
+    /**
+     *  \brief  Implementation (string views, alignment output)
+     *
+     *  The alignment is written to \c out in order, by calls of
+     *  \c out.sub(c1, c2) (aligned characters), \c out.del(c1)
+     *  (\c s1 character against gap) and \c out.ins(c2)
+     *  (gap against \c s2 character).
+     *  The workspace score buffer is reused at every recursion level;
+     *  no other memory is allocated.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  ws       Workspace
+     */
+    template <class Output>
+    void align(
+        const char           * s1, size_t s1_size,
+        const char           * s2, size_t s2_size,
+        Output               & out,
+        hirschberg_workspace & ws)
+    const {
+        ALGORITHM_STATS_TIMER(ALIGN);
+
+        align_impl(s1, s1_size, s2, s2_size, out, m_band,
+            ws.scores(workspace_size(s1_size, s2_size)));
+    }
+
+    /**
+     *  \brief  Implementation (string views, alignment output, parallel)
+     *
+     *  Same as the serial implementation, but the independent sweeps
+     *  and recursion halves are run as \c pool tasks (down to the parallel
+     *  computation cutoff).  The alignment is the same as the serial one.
+     *
+     *  Note that the alignment isn't streamed to \c out: the right halves
+     *  are buffered (up to about half of the alignment length in memory)
+     *  and replayed once the left halves are done.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  ws       Workspace
+     *  \param  pool     Thread pool
+     */
+    template <class Output>
+    void align(
+        const char            * s1, size_t s1_size,
+        const char            * s2, size_t s2_size,
+        Output                & out,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool & pool)
+    const {
+        ALGORITHM_STATS_TIMER(ALIGN);
+
+        align_parallel(s1, s1_size, s2, s2_size, out, m_band,
+            ws.scores(workspace_size(s1_size, s2_size)), pool);
+    }
+
+    /**
+     *  \brief  Implementation (reusable workspace)
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *  \param  ws  Workspace
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string    & s1,
+        const std::string    & s2,
+        hirschberg_workspace & ws)
+    const {
+        return align_padded(s1, s2, ws, NULL);
+    }
+
+    /**
+     *  \brief  Implementation (reusable workspace, parallel)
+     *
+     *  \param  s1    A string
+     *  \param  s2    Another string
+     *  \param  ws    Workspace
+     *  \param  pool  Thread pool
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string     & s1,
+        const std::string     & s2,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool & pool)
+    const {
+        return align_padded(s1, s2, ws, &pool);
+    }
+
+    /**
+     *  \brief  Implementation
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string & s1,
+        const std::string & s2)
+    const {
+        hirschberg_workspace ws;
+        return (*this)(s1, s2, ws);
+    }
+
+    /**
+     *  \brief  Edit script of strings alignment
+     *
+     *  Produces the alignment as run-length encoded edit script
+     *  (see \ref edit_script) instead of padded strings.
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *  \param  ws  Workspace
+     *
+     *  \return Edit script
+     */
+    edit_script script(
+        const std::string    & s1,
+        const std::string    & s2,
+        hirschberg_workspace & ws)
+    const {
+        edit_script out;
+        align(s1.data(), s1.size(), s2.data(), s2.size(), out, ws);
 
-        return return_t(
-            std::get<0>(left) + std::get<0>(right),
-            std::get<1>(left) + std::get<1>(right));
+        return out;
     }
 
 };  // end of template class hirschberg
@@ -39,7 +39,15 @@
  */
 
 
+#include "algorithm/string/levenshtein.hxx"
+#include "algorithm/string/hirschberg.hxx"
+#include "algorithm/parallel/thread_pool.hxx"
+
 #include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 
 
 namespace algorithm {
@@ -56,56 +64,754 @@ inline T min(T a1, Ts... args) {
     return a1 < min_args ? a1 : min_args;
 }
 
+/** Bit-vector word */
+typedef uint64_t word_t;
+
+/** Bit-vector word width */
+static constexpr size_t word_bits = 64;
+
+
+/**
+ *  \brief  Bit-parallel Levenshtein distance (single word)
+ *
+ *  Myers' bit-vector algorithm (in Hyyro's formulation for edit distance).
+ *  Whole column of the distance matrix is represented by vertical
+ *  positive and negative delta bit-vectors, so a column is computed
+ *  by a few word operations.
+ *
+ *  See G. Myers: A fast bit-vector algorithm for approximate string
+ *  matching based on dynamic programming (J. ACM 46(3), 1999) and
+ *  H. Hyyro: Explaining and extending the bit-parallel approximate
+ *  string matching algorithm of Myers (2001).
+ *
+ *  \param  peq     Pattern characters' occurrence bit-vectors (256)
+ *  \param  p_size  Pattern length (1 .. 64)
+ *  \param  t       Text
+ *  \param  t_size  Text length
+ *
+ *  \return Levenshtein distance of the pattern from \c t
+ */
+static size_t levenshtein_dist_word(
+    const word_t * peq, size_t p_size,
+    const char   * t,   size_t t_size)
+{
+    ALGORITHM_STATS_TIMER(DIST);
+    ALGORITHM_STATS_ADD(cells, p_size * t_size);
+
+    const word_t last = (word_t)1 << (p_size - 1);
+
+    word_t pv    = ~(word_t)0;  // vertical positive deltas
+    word_t mv    = 0;           // vertical negative deltas
+    size_t score = p_size;      // distance for empty text prefix
+
+    for (size_t j = 0; j < t_size; ++j) {
+        const word_t eq = peq[(unsigned char)t[j]];
+        const word_t xv = eq | mv;
+        const word_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+        word_t ph = mv | ~(xh | pv);  // horizontal positive deltas
+        word_t mh = pv & xh;          // horizontal negative deltas
+
+        if      (ph & last) ++score;
+        else if (mh & last) --score;
+
+        // Top row distances grow with text prefix length
+        ph = (ph << 1) | 1;
+        mh = mh << 1;
+
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    return score;
+}
+
+
+/**
+ *  \brief  Bit-parallel Levenshtein distance (blocked)
+ *
+ *  Multi-word extension of \ref levenshtein_dist_word.
+ *  The pattern is split to blocks of 64 characters; columns are computed
+ *  block by block, propagating horizontal delta carry between blocks.
+ *
+ *  \param  peq     Pattern characters' occurrence bit-vectors
+ *                  (256 x blocks, character-major)
+ *  \param  p_size  Pattern length (> 64)
+ *  \param  t       Text
+ *  \param  t_size  Text length
+ *  \param  pvs     Vertical positive deltas buffer (blocks)
+ *  \param  mvs     Vertical negative deltas buffer (blocks)
+ *
+ *  \return Levenshtein distance of the pattern from \c t
+ */
+static size_t levenshtein_dist_blocks(
+    const word_t * peq, size_t p_size,
+    const char   * t,   size_t t_size,
+    word_t * pvs, word_t * mvs)
+{
+    ALGORITHM_STATS_TIMER(DIST);
+    ALGORITHM_STATS_ADD(cells, p_size * t_size);
+
+    const size_t blocks = (p_size + word_bits - 1) / word_bits;
+
+    for (size_t b = 0; b < blocks; ++b) {
+        pvs[b] = ~(word_t)0;
+        mvs[b] = 0;
+    }
+
+    const word_t high = (word_t)1 << (word_bits - 1);
+    const word_t last = (word_t)1 << ((p_size - 1) % word_bits);
+
+    size_t score = p_size;
+
+    for (size_t j = 0; j < t_size; ++j) {
+        const word_t * eqs = peq + (unsigned char)t[j] * blocks;
+
+        int hin = 1;  // top row distances grow with text prefix length
+
+        for (size_t b = 0; b < blocks; ++b) {
+            word_t eq = eqs[b];
+            word_t pv = pvs[b];
+            word_t mv = mvs[b];
+
+            const word_t xv = eq | mv;
+            if (hin < 0) eq |= 1;
+            const word_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+            word_t ph = mv | ~(xh | pv);
+            word_t mh = pv & xh;
+
+            // Horizontal delta at the block bottom
+            const word_t out = b + 1 < blocks ? high : last;
+            const int hout = ph & out ? 1 : mh & out ? -1 : 0;
+
+            ph <<= 1;
+            mh <<= 1;
+            if      (hin < 0) mh |= 1;
+            else if (hin > 0) ph |= 1;
+
+            pvs[b] = mh | ~(xv | ph);
+            mvs[b] = ph & xv;
+
+            hin = hout;
+        }
+
+        score += hin;
+    }
+
+    return score;
+}
+
+
+/**
+ *  \brief  Preprocessed bit-parallel pattern
+ *
+ *  Keeps the pattern characters' occurrence bit-vectors and the vertical
+ *  delta buffers, so that the pattern may be matched against many texts.
+ *  The buffers are reused when another pattern is assigned.
+ */
+class bit_pattern {
+    private:
+
+    const char        * m_p;       /**< Pattern                      */
+    size_t              m_size;    /**< Pattern length               */
+    size_t              m_blocks;  /**< Number of bit-vector blocks  */
+    std::vector<word_t> m_peq;     /**< Occurrence bit-vectors       */
+    std::vector<word_t> m_pvs;     /**< Vertical positive deltas     */
+    std::vector<word_t> m_mvs;     /**< Vertical negative deltas     */
+
+    public:
+
+    /** Constructor */
+    bit_pattern(): m_p(NULL), m_size(0), m_blocks(0) {}
+
+    /**
+     *  \brief  Assign pattern
+     *
+     *  The pattern isn't copied; it must exist while it's matched.
+     *
+     *  \param  p       Pattern
+     *  \param  p_size  Pattern length
+     */
+    void assign(const char * p, size_t p_size) {
+        m_p      = p;
+        m_size   = p_size;
+        m_blocks = (p_size + word_bits - 1) / word_bits;
+
+        if (m_peq.capacity() < 256 * m_blocks)
+            ALGORITHM_STATS_ADD(bytes, (256 + 2) * m_blocks * sizeof(word_t));
+
+        m_peq.assign(256 * m_blocks, 0);
+        m_pvs.resize(m_blocks);
+        m_mvs.resize(m_blocks);
+
+        for (size_t i = 0; i < p_size; ++i)
+            m_peq[(unsigned char)p[i] * m_blocks + i / word_bits] |=
+                (word_t)1 << (i % word_bits);
+    }
+
+    /**
+     *  \brief  Levenshtein distance of the pattern from a text
+     *
+     *  \param  t       Text
+     *  \param  t_size  Text length
+     *
+     *  \return Levenshtein distance
+     */
+    size_t dist(const char * t, size_t t_size) {
+        // Corner cases
+        if (0 == m_size) return t_size;
+        if (0 == t_size) return m_size;
+        if (m_size == t_size && 0 == ::memcmp(m_p, t, t_size)) return 0;
+
+        if (1 == m_blocks)
+            return levenshtein_dist_word(m_peq.data(), m_size, t, t_size);
+
+        return levenshtein_dist_blocks(m_peq.data(), m_size, t, t_size,
+            m_pvs.data(), m_mvs.data());
+    }
+
+};  // end of class bit_pattern
+
+/**
+ *  \brief  Banded Levenshtein distance with early exit
+ *
+ *  Ukkonen's cut-off: only the diagonals that an alignment of cost
+ *  at most \c max_k may pass through are computed.
+ *  A diagonal d = j - i is reachable iff |d| + |(|t| - |p|) - d| <= max_k,
+ *  so the band is at most max_k + 1 cells wide.
+ *  Computation stops as soon as the whole band row exceeds \c max_k.
+ *
+ *  The row is kept in diagonal coordinates and updated in-place.
+ *
+ *  \param  p       A string
+ *  \param  p_size  Its length
+ *  \param  t       Another string
+ *  \param  t_size  Its length
+ *  \param  max_k   Distance threshold (must be >= ||p| - |t||)
+ *
+ *  \return Levenshtein distance if <= \c max_k, \c max_k + 1 otherwise
+ */
+static size_t levenshtein_dist_band(
+    const char * p, size_t p_size,
+    const char * t, size_t t_size,
+    size_t max_k)
+{
+    const size_t inf   = max_k + 1;
+    const long   delta = (long)t_size - (long)p_size;
+    const long   slack = ((long)max_k - (delta < 0 ? -delta : delta)) / 2;
+    const long   lo    = (delta < 0 ? delta : 0) - slack;  // lowest diagonal
+    const long   hi    = (delta > 0 ? delta : 0) + slack;  // highest diagonal
+    const size_t width = hi - lo + 1;
+
+    ALGORITHM_STATS_TIMER(DIST);
+
+    // Band row (+ sentinel), r[d] is the distance on diagonal lo + d
+    std::vector<size_t> r(width + 1, inf);
+    ALGORITHM_STATS_ADD(bytes, (width + 1) * sizeof(size_t));
+
+    for (size_t d = 0; d < width; ++d) {
+        const long j = lo + (long)d;
+        if (0 <= j && j <= (long)t_size && (size_t)j < inf) r[d] = j;
+    }
+
+    for (size_t i = 1; i <= p_size; ++i) {
+        size_t left = inf;  // distance to the left (in current row)
+        size_t rmin = inf;  // row minimum
+
+        for (size_t d = 0; d < width; ++d) {
+            const long j = (long)i + lo + (long)d;
+            size_t dist = inf;
+
+            if (0 == j)
+                dist = i < inf ? i : inf;
+
+            else if (0 < j && j <= (long)t_size) {
+                dist = min(
+                    r[d] + (p[i - 1] == t[j - 1] ? 0 : 1),
+                    r[d + 1] + 1,
+                    left + 1);
+
+                if (dist > inf) dist = inf;
+            }
+
+            r[d] = left = dist;
+            if (dist < rmin) rmin = dist;
+        }
+
+        ALGORITHM_STATS_ADD(cells, width);
+
+        // Early exit: the threshold can't be met any longer
+        if (rmin > max_k) {
+            ALGORITHM_STATS_ADD(early_exits, 1);
+            return inf;
+        }
+    }
+
+    return r[delta - lo];
+}
+
+
+/**
+ *  \brief  Levenshtein distance based similarity
+ *
+ *  \param  dist     Levenshtein distance
+ *  \param  s1_size  Length of a string
+ *  \param  s2_size  Length of another string
+ *
+ *  \return Similarity
+ */
+inline double levenshtein_simi(size_t dist, size_t s1_size, size_t s2_size) {
+    if (0 == dist) return 1.0;  // identical strings
+
+    const size_t smax = s1_size < s2_size ? s2_size : s1_size;
+    return 1.0 - (double)dist / smax;
+}
+
+
+/** Batch computation tile height (strings used as patterns) */
+static constexpr size_t tile_rows = 16;
+
+/** Batch computation tile width (strings used as texts) */
+static constexpr size_t tile_cols = 256;
+
+
+/**
+ *  \brief  Batch Levenshtein distance computation
+ *
+ *  The (s1 x s2) matrix is computed by tiles, so that a tile's strings
+ *  stay in cache; each \c s1 string is preprocessed as bit-parallel
+ *  pattern once per tile.  The patterns are kept per thread, so their
+ *  buffers are reused.  If a thread pool is provided, tiles are computed
+ *  as its tasks.
+ *
+ *  \param  s1        Strings
+ *  \param  s1_cnt    Number of \c s1 strings
+ *  \param  s2        Other strings
+ *  \param  s2_cnt    Number of \c s2 strings
+ *  \param  triangle  Compute only (i, j) for j > i
+ *  \param  store     Result store (i, j, dist)
+ *  \param  pool      Thread pool (optional)
+ */
+template <class Store>
+static void levenshtein_batch(
+    const std::string     * s1, size_t s1_cnt,
+    const std::string     * s2, size_t s2_cnt,
+    bool                    triangle,
+    Store                   store,
+    parallel::thread_pool * pool)
+{
+    auto tile = [=](size_t i0, size_t j0) {
+        static thread_local bit_pattern pattern;
+
+        const size_t i1 = min(i0 + tile_rows, s1_cnt);
+        const size_t j1 = min(j0 + tile_cols, s2_cnt);
+
+        for (size_t i = i0; i < i1; ++i) {
+            size_t j = triangle && i + 1 > j0 ? i + 1 : j0;
+            if (j >= j1) continue;
+
+            pattern.assign(s1[i].data(), s1[i].size());
+            for (; j < j1; ++j)
+                store(i, j, pattern.dist(s2[j].data(), s2[j].size()));
+        }
+    };
+
+    std::unique_ptr<parallel::task_group> tiles;
+    if (NULL != pool) tiles.reset(new parallel::task_group(*pool));
+
+    for (size_t i0 = 0; i0 < s1_cnt; i0 += tile_rows) {
+        size_t j0 = triangle ? (i0 + 1) / tile_cols * tile_cols : 0;
+
+        for (; j0 < s2_cnt; j0 += tile_cols) {
+            if (tiles)
+                tiles->run([=]() { tile(i0, j0); });
+            else
+                tile(i0, j0);
+        }
+    }
+
+    if (tiles) tiles->wait();
+}
+
 }  // end of namespace impl
 
 
+size_t levenshtein_dist(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size)
+{
+    // Corner cases
+    if (0 == s1_size) return s2_size;
+    if (0 == s2_size) return s1_size;
+    if (s1_size == s2_size && 0 == ::memcmp(s1, s2, s1_size)) return 0;
+
+    // The shorter string is used as the pattern (less bit-vector blocks)
+    const bool   swap   = s2_size < s1_size;
+    const char * p      = swap ? s2 : s1;
+    const size_t p_size = swap ? s2_size : s1_size;
+    const char * t      = swap ? s1 : s2;
+    const size_t t_size = swap ? s1_size : s2_size;
+
+    // Whole column fits a single word
+    if (p_size <= impl::word_bits) {
+        impl::word_t peq[256];
+        ::memset(peq, 0, sizeof(peq));
+
+        for (size_t i = 0; i < p_size; ++i)
+            peq[(unsigned char)p[i]] |= (impl::word_t)1 << i;
+
+        return impl::levenshtein_dist_word(peq, p_size, t, t_size);
+    }
+
+    impl::bit_pattern pattern;
+    pattern.assign(p, p_size);
+
+    return pattern.dist(t, t_size);
+}
+
+
 size_t levenshtein_dist(const std::string & s1, const std::string & s2) {
-    const size_t s1_size = s1.size();
-    const size_t s2_size = s2.size();
+    return levenshtein_dist(s1.data(), s1.size(), s2.data(), s2.size());
+}
+
+
+double levenshtein_simi(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size)
+{
+    const size_t dist = levenshtein_dist(s1, s1_size, s2, s2_size);
+    return impl::levenshtein_simi(dist, s1_size, s2_size);
+}
+
+
+double levenshtein_simi(const std::string & s1, const std::string & s2) {
+    return levenshtein_simi(s1.data(), s1.size(), s2.data(), s2.size());
+}
+
+
+size_t levenshtein_dist(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size,
+    size_t       max_k)
+{
+    // Length difference alone exceeds the threshold
+    const size_t diff = s1_size < s2_size
+        ? s2_size - s1_size
+        : s1_size - s2_size;
+
+    if (diff > max_k) {
+        ALGORITHM_STATS_ADD(early_exits, 1);
+        return max_k + 1;
+    }
 
     // Corner cases
-    if (0  == s1_size) return s2_size;
-    if (0  == s2_size) return s1_size;
-    if (s1 == s2)      return 0;
-
-    // Last 2 dist. matrix rows
-    size_t   ra[s2_size + 1];
-    size_t   rb[s2_size + 1];
-    size_t * r0 = ra;
-    size_t * r1 = rb;
-
-    // Initialize r0 (the previous row of distances)
-    // by edit distance for empty s1 (i.e. length of s2 prefix)
-    for (size_t i = 0; i < s2_size + 1; i++)
-        r0[i] = i;
-
-    // Calculate next row r1 (done at least once)
-    for (size_t i = 0; i < s1_size; i++) {
-        r1[0] = i + 1;  // delete i + 1 chars to match empty string
-
-        // Rest of the row
-        for (size_t j = 0; j < s2_size; j++)
-            r1[j + 1] = impl::min(
-                r1[j] + 1,
-                r0[j + 1] + 1,
-                r0[j] + (s1[i] == s2[j] ? 0 : 1));
-
-        // Swap rows for next iteration
-        size_t * rs = r0;
-        r0 = r1;
-        r1 = rs;
+    if (0 == s1_size) return s2_size;
+    if (0 == s2_size) return s1_size;
+    if (s1_size == s2_size && 0 == ::memcmp(s1, s2, s1_size)) return 0;
+
+    // Threshold doesn't restrict the computation
+    if (max_k >= s1_size || max_k >= s2_size) {
+        const size_t dist = levenshtein_dist(s1, s1_size, s2, s2_size);
+        return dist > max_k ? max_k + 1 : dist;
     }
 
-    return r0[s2_size];
+    return impl::levenshtein_dist_band(s1, s1_size, s2, s2_size, max_k);
 }
 
 
-double levenshtein_simi(const std::string & s1, const std::string & s2) {
-    const size_t dist = levenshtein_dist(s1, s2);
-    if (0 == dist) return 1.0;  // identical strings
+edit_script levenshtein_script(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size)
+{
+    typedef hirschberg<const_cost, const_cost, match_cost> unit_cost_t;
+
+    static const unit_cost_t unit_cost(
+        const_cost(-1), const_cost(-1), match_cost(0, -1));
+
+    static thread_local hirschberg_workspace ws;
+
+    edit_script script;
+    unit_cost.align(s1, s1_size, s2, s2_size, script, ws);
+
+    return script;
+}
+
+
+edit_script levenshtein_script(const std::string & s1, const std::string & s2)
+{
+    return levenshtein_script(s1.data(), s1.size(), s2.data(), s2.size());
+}
+
+
+size_t levenshtein_dist(
+    const std::string & s1,
+    const std::string & s2,
+    size_t              max_k)
+{
+    return levenshtein_dist(
+        s1.data(), s1.size(), s2.data(), s2.size(), max_k);
+}
+
+
+double levenshtein_simi(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size,
+    double       min_simi)
+{
+    // No similarity reaches threshold above 1 (or NaN)
+    if (!(min_simi <= 1.0)) return 0.0;
+
+    const size_t smax = s1_size < s2_size ? s2_size : s1_size;
+    if (0 == smax) return 1.0;  // both strings empty
+
+    // Max. distance allowed (the epsilon compensates rounding errors,
+    // the similarity is checked explicitly at the end)
+    const double max_k_real = (1.0 - min_simi) * smax + 1e-9;
+    const size_t max_k      = max_k_real < smax ? (size_t)max_k_real : smax;
+
+    const size_t dist = levenshtein_dist(s1, s1_size, s2, s2_size, max_k);
+    if (dist > max_k) return 0.0;
+
+    const double simi = 1.0 - (double)dist / smax;
+    return simi < min_simi ? 0.0 : simi;
+}
+
+
+double levenshtein_simi(
+    const std::string & s1,
+    const std::string & s2,
+    double              min_simi)
+{
+    return levenshtein_simi(
+        s1.data(), s1.size(), s2.data(), s2.size(), min_simi);
+}
+
+
+void utf8_decode(const char * s, size_t size, std::vector<uint32_t> & cps) {
+    const unsigned char * u = (const unsigned char *)s;
+
+    for (size_t i = 0; i < size; ) {
+        const uint32_t b = u[i];
+
+        // ASCII
+        if (b < 0x80) {
+            cps.push_back(b);
+            ++i;
+            continue;
+        }
+
+        // Sequence length and 2nd byte range (excludes overlong forms,
+        // surrogates and code points above U+10FFFF)
+        size_t        len = 0;
+        unsigned char lo  = 0x80, hi = 0xbf;
+
+        if      (0xc2 <= b && b <= 0xdf) len = 2;
+        else if (0xe0 == b)            { len = 3; lo = 0xa0; }
+        else if (0xed == b)            { len = 3; hi = 0x9f; }
+        else if (0xe1 <= b && b <= 0xef) len = 3;
+        else if (0xf0 == b)            { len = 4; lo = 0x90; }
+        else if (0xf4 == b)            { len = 4; hi = 0x8f; }
+        else if (0xf1 <= b && b <= 0xf3) len = 4;
+
+        bool valid = 0 < len && i + len <= size &&
+            lo <= u[i + 1] && u[i + 1] <= hi;
+
+        for (size_t k = 2; valid && k < len; ++k)
+            valid = 0x80 == (u[i + k] & 0xc0);
+
+        // Invalid byte
+        if (!valid) {
+            cps.push_back(0xdc00 + b);
+            ++i;
+            continue;
+        }
+
+        uint32_t cp = b & (0x7f >> len);
+        for (size_t k = 1; k < len; ++k)
+            cp = (cp << 6) | (u[i + k] & 0x3f);
+
+        cps.push_back(cp);
+        i += len;
+    }
+}
+
+
+/**
+ *  \brief  Check that a string is pure ASCII
+ *
+ *  \param  s     String
+ *  \param  size  String length
+ *
+ *  \return \c true iff \c s has no bytes >= 0x80
+ */
+static bool is_ascii(const char * s, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+        if (s[i] & 0x80) return false;
+
+    return true;
+}
+
+
+/** Per-thread UTF-8 decoding buffers */
+struct utf8_buffers {
+    levenshtein_workspace ws;    /**< Distance workspace        */
+    std::vector<uint32_t> cps1;  /**< Code points of a string   */
+    std::vector<uint32_t> cps2;  /**< Code points of the other  */
+
+    /** Decode the strings */
+    void decode(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size)
+    {
+        cps1.clear();
+        cps2.clear();
+        utf8_decode(s1, s1_size, cps1);
+        utf8_decode(s2, s2_size, cps2);
+    }
+
+};  // end of struct utf8_buffers
+
+static thread_local utf8_buffers utf8_bufs;
+
+
+size_t levenshtein_dist_utf8(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size)
+{
+    if (is_ascii(s1, s1_size) && is_ascii(s2, s2_size))
+        return levenshtein_dist(s1, s1_size, s2, s2_size);
+
+    utf8_buffers & bufs = utf8_bufs;
+    bufs.decode(s1, s1_size, s2, s2_size);
+
+    return levenshtein_dist(bufs.cps1.begin(), bufs.cps1.end(),
+        bufs.cps2.begin(), bufs.cps2.end(), bufs.ws);
+}
+
+
+size_t levenshtein_dist_utf8(const std::string & s1, const std::string & s2) {
+    return levenshtein_dist_utf8(s1.data(), s1.size(), s2.data(), s2.size());
+}
+
+
+double levenshtein_simi_utf8(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size)
+{
+    if (is_ascii(s1, s1_size) && is_ascii(s2, s2_size))
+        return levenshtein_simi(s1, s1_size, s2, s2_size);
+
+    utf8_buffers & bufs = utf8_bufs;
+    bufs.decode(s1, s1_size, s2, s2_size);
+
+    return levenshtein_simi(bufs.cps1.begin(), bufs.cps1.end(),
+        bufs.cps2.begin(), bufs.cps2.end(), bufs.ws);
+}
+
+
+double levenshtein_simi_utf8(const std::string & s1, const std::string & s2) {
+    return levenshtein_simi_utf8(s1.data(), s1.size(), s2.data(), s2.size());
+}
+
+
+void levenshtein_dist(
+    const std::string              & query,
+    const std::vector<std::string> & candidates,
+    size_t                         * dist,
+    parallel::thread_pool          * pool)
+{
+    impl::levenshtein_batch(
+        &query, 1, candidates.data(), candidates.size(), false,
+        [dist](size_t, size_t j, size_t d) { dist[j] = d; },
+        pool);
+}
+
+
+void levenshtein_simi(
+    const std::string              & query,
+    const std::vector<std::string> & candidates,
+    double                         * simi,
+    parallel::thread_pool          * pool)
+{
+    const std::string * cands = candidates.data();
+    const size_t        q_size = query.size();
+
+    impl::levenshtein_batch(
+        &query, 1, cands, candidates.size(), false,
+        [simi, cands, q_size](size_t, size_t j, size_t d) {
+            simi[j] = impl::levenshtein_simi(d, q_size, cands[j].size());
+        },
+        pool);
+}
+
+
+void levenshtein_dist(
+    const std::vector<std::string> & s1,
+    const std::vector<std::string> & s2,
+    size_t                         * dist,
+    parallel::thread_pool          * pool)
+{
+    const size_t cols = s2.size();
+
+    impl::levenshtein_batch(
+        s1.data(), s1.size(), s2.data(), s2.size(), false,
+        [dist, cols](size_t i, size_t j, size_t d) { dist[i * cols + j] = d; },
+        pool);
+}
+
+
+void levenshtein_simi(
+    const std::vector<std::string> & s1,
+    const std::vector<std::string> & s2,
+    double                         * simi,
+    parallel::thread_pool          * pool)
+{
+    const std::string * rows = s1.data();
+    const std::string * cols = s2.data();
+    const size_t        cnt  = s2.size();
+
+    impl::levenshtein_batch(
+        rows, s1.size(), cols, cnt, false,
+        [simi, rows, cols, cnt](size_t i, size_t j, size_t d) {
+            simi[i * cnt + j] = impl::levenshtein_simi(
+                d, rows[i].size(), cols[j].size());
+        },
+        pool);
+}
+
+
+void levenshtein_dist(
+    const std::vector<std::string> & s,
+    size_t                         * dist,
+    parallel::thread_pool          * pool)
+{
+    const size_t n = s.size();
+
+    impl::levenshtein_batch(
+        s.data(), n, s.data(), n, true,
+        [dist, n](size_t i, size_t j, size_t d) {
+            dist[i * n - i * (i + 1) / 2 + j - i - 1] = d;
+        },
+        pool);
+}
+
+
+void levenshtein_simi(
+    const std::vector<std::string> & s,
+    double                         * simi,
+    parallel::thread_pool          * pool)
+{
+    const std::string * str = s.data();
+    const size_t        n   = s.size();
 
-    const size_t smax = -impl::min(-(long)s1.size(), -(long)s2.size());
-    return 1.0 - (double)dist / smax;  // note that surely, smax > 0
+    impl::levenshtein_batch(
+        str, n, str, n, true,
+        [simi, str, n](size_t i, size_t j, size_t d) {
+            simi[i * n - i * (i + 1) / 2 + j - i - 1] =
+                impl::levenshtein_simi(d, str[i].size(), str[j].size());
+        },
+        pool);
 }
 
 }}  // end of namespaces string algorithm
@@ -42,10 +42,23 @@
  */
 
 
+#include "algorithm/string/edit_script.hxx"
+#include "algorithm/string/stats.hxx"
+
 #include <string>
+#include <vector>
+#include <iterator>
+#include <cstdint>
 
 
 namespace algorithm {
+
+namespace parallel {
+
+class thread_pool;
+
+}  // end of namespace parallel
+
 namespace string {
 
 /**
@@ -61,6 +74,24 @@ namespace string {
 size_t levenshtein_dist(const std::string & s1, const std::string & s2);
 
 
+/**
+ *  \brief  Levenshtein distance of character sequences
+ *
+ *  Same as the \c std::string overload; allows for computation
+ *  on data in place (e.g. memory-mapped input) without copying.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2
+ */
+size_t levenshtein_dist(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size);
+
+
 /**
  *  \brief  Levenshtein distance based string similarity measure
  *
@@ -81,6 +112,526 @@ size_t levenshtein_dist(const std::string & s1, const std::string & s2);
  */
 double levenshtein_simi(const std::string & s1, const std::string & s2);
 
+
+/**
+ *  \brief  Levenshtein similarity of character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2
+ *
+ *  \return Reversed normalised Levenshtein distance of \c s1 from \c s2
+ */
+double levenshtein_simi(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size);
+
+
+/**
+ *  \brief  Thresholded Levenshtein distance of strings
+ *
+ *  Decides whether \c s1 and \c s2 are within \c max_k edits.
+ *  The strings are rejected immediately if their lengths differ
+ *  by more than \c max_k; otherwise, only the diagonal band of the distance
+ *  matrix that may contain a path of cost <= \c max_k is computed
+ *  (Ukkonen) and the computation stops as soon as all the band cells
+ *  of a row exceed \c max_k.
+ *
+ *  \param  s1     A string
+ *  \param  s2     Another string
+ *  \param  max_k  Distance threshold
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2 if it's <= \c max_k,
+ *          \c max_k + 1 otherwise
+ */
+size_t levenshtein_dist(
+    const std::string & s1,
+    const std::string & s2,
+    size_t              max_k);
+
+
+/**
+ *  \brief  Thresholded Levenshtein distance of character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2
+ *  \param  max_k    Distance threshold
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2 if it's <= \c max_k,
+ *          \c max_k + 1 otherwise
+ */
+size_t levenshtein_dist(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size,
+    size_t       max_k);
+
+
+/**
+ *  \brief  Thresholded Levenshtein distance based string similarity
+ *
+ *  The minimal similarity is turned into the matching distance threshold
+ *  (floor((1 - \c min_simi) * max(|\c s1|, |\c s2|))) and the thresholded
+ *  distance computation is used.
+ *  Threshold greater than 1 (or NaN) is never reached.
+ *
+ *  \param  s1        A string
+ *  \param  s2        Another string
+ *  \param  min_simi  Minimal similarity
+ *
+ *  \return Similarity of \c s1 and \c s2 if it's >= \c min_simi,
+ *          0 otherwise
+ */
+double levenshtein_simi(
+    const std::string & s1,
+    const std::string & s2,
+    double              min_simi);
+
+
+/**
+ *  \brief  Thresholded Levenshtein similarity of character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1        A string
+ *  \param  s1_size   Length of \c s1
+ *  \param  s2        Another string
+ *  \param  s2_size   Length of \c s2
+ *  \param  min_simi  Minimal similarity
+ *
+ *  \return Similarity of \c s1 and \c s2 if it's >= \c min_simi,
+ *          0 otherwise
+ */
+double levenshtein_simi(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size,
+    double       min_simi);
+
+
+/**
+ *  \brief  Levenshtein edit script
+ *
+ *  Computes a minimal sequence of edits turning \c s1 into \c s2
+ *  (by Hirschberg's alignment with unit edit costs), as run-length
+ *  encoded edit script.  The number of its edits is the Levenshtein
+ *  distance of the strings.
+ *
+ *  \param  s1  A string
+ *  \param  s2  Another string
+ *
+ *  \return Edit script
+ */
+edit_script levenshtein_script(const std::string & s1, const std::string & s2);
+
+
+/**
+ *  \brief  Levenshtein edit script of character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2
+ *
+ *  \return Edit script
+ */
+edit_script levenshtein_script(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size);
+
+
+/**
+ *  \brief  Levenshtein distance workspace
+ *
+ *  Keeps the distance row buffer of the generic distance computation,
+ *  so that it may be reused by subsequent computations (no allocation
+ *  takes place once the buffer is large enough).
+ *  Not thread-safe; use one workspace per thread.
+ */
+class levenshtein_workspace {
+    private:
+
+    std::vector<uint64_t> m_buffer;  /**< Row buffer */
+
+    public:
+
+    /**
+     *  \brief  Distance row buffer (grows if necessary)
+     *
+     *  \tparam  T     Distance type
+     *  \param   size  Required number of distances
+     *
+     *  \return Row buffer
+     */
+    template <typename T>
+    T * row(size_t size) {
+        const size_t words =
+            (size * sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        if (m_buffer.size() < words) {
+            m_buffer.resize(words);
+            ALGORITHM_STATS_ADD(bytes, words * sizeof(uint64_t));
+        }
+
+        return reinterpret_cast<T *>(m_buffer.data());
+    }
+
+};  // end of class levenshtein_workspace
+
+
+namespace impl {
+
+/**
+ *  \brief  Levenshtein distance of sequences (generic)
+ *
+ *  Wagner-Fischer algorithm; a single distance row (for the \c s2
+ *  sequence) is kept.  Distances are stored as \c T, which must be able
+ *  to hold max(|s1|, |s2|).
+ *
+ *  \tparam  T  Distance type
+ *
+ *  \param  s1       A sequence
+ *  \param  s1_size  Length of \c s1
+ *  \param  s2       Another sequence
+ *  \param  s2_size  Length of \c s2
+ *  \param  row      Row buffer (|s2| + 1 distances)
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2
+ */
+template <typename T, class It1, class It2>
+size_t levenshtein_dist_seq(
+    It1 s1, size_t s1_size,
+    It2 s2, size_t s2_size,
+    T * row)
+{
+    ALGORITHM_STATS_TIMER(DIST);
+    ALGORITHM_STATS_ADD(cells, s1_size * s2_size);
+
+    for (size_t j = 0; j <= s2_size; ++j) row[j] = (T)j;
+
+    for (size_t i = 1; i <= s1_size; ++i, ++s1) {
+        T diag = row[0];  // distance of the preceding prefixes
+        row[0] = (T)i;
+
+        It2 s2_j = s2;
+        for (size_t j = 1; j <= s2_size; ++j, ++s2_j) {
+            const T up   = row[j];
+            const T left = row[j - 1];
+
+            T dist = *s1 == *s2_j ? diag : (T)(diag + 1);
+            if (up   < dist) dist = (T)(up   + 1);
+            if (left < dist) dist = (T)(left + 1);
+
+            row[j] = dist;
+            diag   = up;
+        }
+    }
+
+    return row[s2_size];
+}
+
+}  // end of namespace impl
+
+
+/**
+ *  \brief  Levenshtein distance of sequences
+ *
+ *  Generic distance of sequences of any element type comparable by
+ *  \c == (e.g. Unicode code points, token IDs).
+ *  The distances are kept in the narrowest type able to hold them
+ *  (\c uint8_t, \c uint16_t or \c uint32_t, depending on the sequences'
+ *  lengths), so that more of the computation fits in cache.
+ *  The computation makes no allocation once the workspace is large
+ *  enough.
+ *
+ *  Note that byte strings are better served by the \c std::string
+ *  (or \c char array) overloads, which use a bit-parallel algorithm.
+ *
+ *  \param  s1_begin  A sequence begin
+ *  \param  s1_end    A sequence end
+ *  \param  s2_begin  Another sequence begin
+ *  \param  s2_end    Another sequence end
+ *  \param  ws        Workspace
+ *
+ *  \return Levenshtein distance of the sequences
+ */
+template <class It1, class It2>
+size_t levenshtein_dist(
+    It1 s1_begin, It1 s1_end,
+    It2 s2_begin, It2 s2_end,
+    levenshtein_workspace & ws)
+{
+    const size_t s1_size = std::distance(s1_begin, s1_end);
+    const size_t s2_size = std::distance(s2_begin, s2_end);
+
+    // Corner cases
+    if (0 == s1_size) return s2_size;
+    if (0 == s2_size) return s1_size;
+
+    // The shorter sequence is used for the row
+    if (s1_size < s2_size)
+        return levenshtein_dist(s2_begin, s2_end, s1_begin, s1_end, ws);
+
+    // Narrowest distance type sufficient
+    const size_t max_dist = s1_size;
+
+    if (max_dist <= UINT8_MAX)
+        return impl::levenshtein_dist_seq(s1_begin, s1_size,
+            s2_begin, s2_size, ws.row<uint8_t>(s2_size + 1));
+
+    if (max_dist <= UINT16_MAX)
+        return impl::levenshtein_dist_seq(s1_begin, s1_size,
+            s2_begin, s2_size, ws.row<uint16_t>(s2_size + 1));
+
+    if (max_dist <= UINT32_MAX)
+        return impl::levenshtein_dist_seq(s1_begin, s1_size,
+            s2_begin, s2_size, ws.row<uint32_t>(s2_size + 1));
+
+    return impl::levenshtein_dist_seq(s1_begin, s1_size,
+        s2_begin, s2_size, ws.row<size_t>(s2_size + 1));
+}
+
+
+/**
+ *  \brief  Levenshtein distance of sequences (temporary workspace)
+ *
+ *  \param  s1_begin  A sequence begin
+ *  \param  s1_end    A sequence end
+ *  \param  s2_begin  Another sequence begin
+ *  \param  s2_end    Another sequence end
+ *
+ *  \return Levenshtein distance of the sequences
+ */
+template <class It1, class It2>
+size_t levenshtein_dist(
+    It1 s1_begin, It1 s1_end,
+    It2 s2_begin, It2 s2_end)
+{
+    levenshtein_workspace ws;
+    return levenshtein_dist(s1_begin, s1_end, s2_begin, s2_end, ws);
+}
+
+
+/**
+ *  \brief  Levenshtein similarity of sequences
+ *
+ *  See \c std::string overload and the generic distance.
+ *
+ *  \param  s1_begin  A sequence begin
+ *  \param  s1_end    A sequence end
+ *  \param  s2_begin  Another sequence begin
+ *  \param  s2_end    Another sequence end
+ *  \param  ws        Workspace
+ *
+ *  \return Reversed normalised Levenshtein distance of the sequences
+ */
+template <class It1, class It2>
+double levenshtein_simi(
+    It1 s1_begin, It1 s1_end,
+    It2 s2_begin, It2 s2_end,
+    levenshtein_workspace & ws)
+{
+    const size_t s1_size = std::distance(s1_begin, s1_end);
+    const size_t s2_size = std::distance(s2_begin, s2_end);
+    const size_t smax    = s1_size < s2_size ? s2_size : s1_size;
+    if (0 == smax) return 1.0;
+
+    const size_t dist =
+        levenshtein_dist(s1_begin, s1_end, s2_begin, s2_end, ws);
+
+    return 1.0 - (double)dist / smax;
+}
+
+
+/**
+ *  \brief  UTF-8 decoding
+ *
+ *  Decodes UTF-8 string to Unicode code points.  Invalid bytes
+ *  (and bytes of invalid or overlong sequences) are decoded
+ *  to U+DC80 .. U+DCFF (i.e. the byte value + 0xDC00, like Python's
+ *  "surrogateescape"), so that different invalid bytes don't match.
+ *
+ *  \param  s     UTF-8 string
+ *  \param  size  String length (in bytes)
+ *  \param  cps   Code points (appended)
+ */
+void utf8_decode(const char * s, size_t size, std::vector<uint32_t> & cps);
+
+
+/**
+ *  \brief  Levenshtein distance of UTF-8 strings
+ *
+ *  The distance is computed on Unicode code points (see
+ *  \ref utf8_decode); pure ASCII strings are computed directly
+ *  (bit-parallel).  Per-thread buffers are reused.
+ *
+ *  \param  s1  A string
+ *  \param  s2  Another string
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2 (in code points)
+ */
+size_t levenshtein_dist_utf8(const std::string & s1, const std::string & s2);
+
+
+/**
+ *  \brief  Levenshtein distance of UTF-8 character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1 (in bytes)
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2 (in bytes)
+ *
+ *  \return Levenshtein distance of \c s1 from \c s2 (in code points)
+ */
+size_t levenshtein_dist_utf8(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size);
+
+
+/**
+ *  \brief  Levenshtein similarity of UTF-8 strings
+ *
+ *  See \ref levenshtein_dist_utf8; the lengths are in code points.
+ *
+ *  \param  s1  A string
+ *  \param  s2  Another string
+ *
+ *  \return Reversed normalised Levenshtein distance of \c s1 from \c s2
+ */
+double levenshtein_simi_utf8(const std::string & s1, const std::string & s2);
+
+
+/**
+ *  \brief  Levenshtein similarity of UTF-8 character sequences
+ *
+ *  See the \c std::string overload.
+ *
+ *  \param  s1       A string
+ *  \param  s1_size  Length of \c s1 (in bytes)
+ *  \param  s2       Another string
+ *  \param  s2_size  Length of \c s2 (in bytes)
+ *
+ *  \return Reversed normalised Levenshtein distance of \c s1 from \c s2
+ */
+double levenshtein_simi_utf8(
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size);
+
+
+/**
+ *  \brief  Levenshtein distances of a query from candidates
+ *
+ *  The query is preprocessed once and matched against all the candidates.
+ *  If a thread pool is provided, the candidates are split to chunks
+ *  computed by the pool threads.
+ *
+ *  \param  query       Query string
+ *  \param  candidates  Candidate strings
+ *  \param  dist        Distances (|\c candidates| items, caller-provided)
+ *  \param  pool        Thread pool (optional)
+ */
+void levenshtein_dist(
+    const std::string              & query,
+    const std::vector<std::string> & candidates,
+    size_t                         * dist,
+    parallel::thread_pool          * pool = NULL);
+
+
+/**
+ *  \brief  Levenshtein similarities of a query to candidates
+ *
+ *  See the distance counterpart.
+ *
+ *  \param  query       Query string
+ *  \param  candidates  Candidate strings
+ *  \param  simi        Similarities (|\c candidates| items, caller-provided)
+ *  \param  pool        Thread pool (optional)
+ */
+void levenshtein_simi(
+    const std::string              & query,
+    const std::vector<std::string> & candidates,
+    double                         * simi,
+    parallel::thread_pool          * pool = NULL);
+
+
+/**
+ *  \brief  Levenshtein distance matrix
+ *
+ *  The matrix is computed by cache-sized tiles (in parallel if a thread
+ *  pool is provided); per-thread buffers are reused.
+ *
+ *  \param  s1    Strings
+ *  \param  s2    Other strings
+ *  \param  dist  Distances (|\c s1| x |\c s2| row-major matrix,
+ *                caller-provided)
+ *  \param  pool  Thread pool (optional)
+ */
+void levenshtein_dist(
+    const std::vector<std::string> & s1,
+    const std::vector<std::string> & s2,
+    size_t                         * dist,
+    parallel::thread_pool          * pool = NULL);
+
+
+/**
+ *  \brief  Levenshtein similarity matrix
+ *
+ *  See the distance counterpart.
+ *
+ *  \param  s1    Strings
+ *  \param  s2    Other strings
+ *  \param  simi  Similarities (|\c s1| x |\c s2| row-major matrix,
+ *                caller-provided)
+ *  \param  pool  Thread pool (optional)
+ */
+void levenshtein_simi(
+    const std::vector<std::string> & s1,
+    const std::vector<std::string> & s2,
+    double                         * simi,
+    parallel::thread_pool          * pool = NULL);
+
+
+/**
+ *  \brief  All-pairs Levenshtein distances
+ *
+ *  Computes distances of all pairs s[i], s[j] for i < j (upper triangle
+ *  of the distance matrix), stored row-major without the diagonal:
+ *  distance of s[i] and s[j] is at index i * n - i * (i + 1) / 2 + j - i - 1
+ *  (where n = |\c s|).
+ *
+ *  \param  s     Strings
+ *  \param  dist  Distances (n * (n - 1) / 2 items, caller-provided)
+ *  \param  pool  Thread pool (optional)
+ */
+void levenshtein_dist(
+    const std::vector<std::string> & s,
+    size_t                         * dist,
+    parallel::thread_pool          * pool = NULL);
+
+
+/**
+ *  \brief  All-pairs Levenshtein similarities
+ *
+ *  See the distance counterpart (the same layout is used).
+ *
+ *  \param  s     Strings
+ *  \param  simi  Similarities (n * (n - 1) / 2 items, caller-provided)
+ *  \param  pool  Thread pool (optional)
+ */
+void levenshtein_simi(
+    const std::vector<std::string> & s,
+    double                         * simi,
+    parallel::thread_pool          * pool = NULL);
+
 }}  // end of namespaces string algorithm
 
 #endif  // end of #ifndef algorithm__string__levenshtein_hxx
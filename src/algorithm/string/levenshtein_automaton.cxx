@@ -0,0 +1,149 @@
+/**
+ *  \file
+ *  \brief  Levenshtein automaton
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/string/levenshtein_automaton.hxx"
+
+#include <map>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace algorithm {
+namespace string {
+
+constexpr levenshtein_automaton::state_t levenshtein_automaton::dead;
+constexpr levenshtein_automaton::state_t levenshtein_automaton::start;
+constexpr size_t levenshtein_automaton::max_states_dflt;
+
+
+levenshtein_automaton::levenshtein_automaton(
+    const std::string & query,
+    size_t              max_k,
+    size_t              max_states)
+:
+    m_max_k(max_k),
+    m_classes(1)
+{
+    if (max_k > 254)
+        throw std::invalid_argument(
+            "Levenshtein automaton: distance threshold too great");
+
+    typedef std::vector<unsigned char> row_t;
+
+    const size_t        q_size = query.size();
+    const unsigned char inf    = max_k + 1;
+
+    // Character classes (class 0 means no occurrence in query)
+    ::memset(m_class, 0, sizeof(m_class));
+
+    std::vector<int> class_chars(1, -1);  // class representatives
+    for (size_t i = 0; i < q_size; ++i) {
+        const unsigned char c = query[i];
+        if (m_class[c]) continue;
+
+        m_class[c] = m_classes++;
+        class_chars.push_back(c);
+    }
+
+    // States (distance matrix rows)
+    std::map<row_t, state_t> state_ids;
+    std::vector<row_t>       rows;
+
+    rows.push_back(row_t(q_size + 1, inf));  // dead state
+
+    row_t row(q_size + 1);
+    for (size_t i = 0; i <= q_size; ++i)
+        row[i] = i < inf ? i : inf;
+
+    state_ids[row] = start;
+    rows.push_back(row);
+
+    // Enumerate the reachable states (breadth-first)
+    for (state_t state = 0; state < rows.size(); ++state) {
+        m_delta.resize(m_delta.size() + m_classes, dead);
+        if (dead == state) continue;
+
+        for (size_t cls = 0; cls < m_classes; ++cls) {
+            const row_t & prev = rows[state];
+            const int     c    = class_chars[cls];
+
+            row[0] = prev[0] < inf ? prev[0] + 1 : inf;
+            unsigned char row_min = row[0];
+
+            for (size_t i = 1; i <= q_size; ++i) {
+                // Computed wider than the row entries (inf + 1 may wrap)
+                unsigned dist = prev[i - 1] +
+                    ((unsigned char)query[i - 1] == c ? 0 : 1);
+
+                if (prev[i] + 1u < dist) dist = prev[i] + 1u;
+                if (row[i - 1] + 1u < dist) dist = row[i - 1] + 1u;
+                if (dist > inf) dist = inf;
+
+                row[i] = (unsigned char)dist;
+                if (dist < row_min) row_min = dist;
+            }
+
+            // All the distances exceed the threshold
+            if (row_min == inf) continue;
+
+            auto ins = state_ids.insert(
+                std::make_pair(row, (state_t)rows.size()));
+
+            if (ins.second) {
+                if (rows.size() >= max_states)
+                    throw std::runtime_error(
+                        "Levenshtein automaton: too many states");
+
+                rows.push_back(row);
+            }
+
+            m_delta[state * m_classes + cls] = ins.first->second;
+        }
+    }
+
+    // Distances on input end
+    m_dist.reserve(rows.size());
+    for (const auto & r: rows)
+        m_dist.push_back(r[q_size]);
+}
+
+}}  // end of namespaces string algorithm
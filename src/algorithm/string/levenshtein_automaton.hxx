@@ -0,0 +1,161 @@
+#ifndef algorithm__string__levenshtein_automaton_hxx
+#define algorithm__string__levenshtein_automaton_hxx
+
+/**
+ *  \file
+ *  \brief  Levenshtein automaton
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  Levenshtein automaton
+ *
+ *  Deterministic finite automaton accepting strings within \c max_k
+ *  edits from a query.  The query is compiled once; a candidate is then
+ *  checked by a single table lookup per character and rejected as soon
+ *  as the automaton enters its dead state.
+ *
+ *  The states are the rows of the Levenshtein distance matrix of the query
+ *  and a candidate prefix, with distances capped at max_k + 1
+ *  (as in Schulz & Mihov: Fast string correction with Levenshtein
+ *  automata, 2002; the states are however enumerated for the specific
+ *  query instead of using the universal parametric automaton).
+ *  Characters not occurring in the query share a single transition,
+ *  so the transition table has (distinct query characters + 1) columns.
+ *  A row lists distance of the candidate prefix from each query prefix,
+ *  so for an accepted candidate, the exact distance is known.
+ *
+ *  Note that the number of states grows quickly with \c max_k;
+ *  the automaton is intended for small thresholds.
+ */
+class levenshtein_automaton {
+    private:
+
+    typedef uint32_t state_t;  /**< State identifier */
+
+    static constexpr state_t dead  = 0;  /**< Dead state    */
+    static constexpr state_t start = 1;  /**< Initial state */
+
+    size_t               m_max_k;       /**< Distance threshold         */
+    size_t               m_classes;     /**< Character classes          */
+    unsigned char        m_class[256];  /**< Character class map        */
+    std::vector<state_t> m_delta;       /**< Transition table           */
+    std::vector<size_t>  m_dist;        /**< Distance on input end      */
+
+    public:
+
+    /** Max. number of states (default) */
+    static constexpr size_t max_states_dflt = 1 << 20;
+
+    /**
+     *  \brief  Constructor (compiles the automaton)
+     *
+     *  Throws an exception if the automaton would have more than
+     *  \c max_states states (or \c max_k > 254; row entries are stored
+     *  as bytes, capped at \c max_k + 1).
+     *
+     *  \param  query       Query
+     *  \param  max_k       Distance threshold
+     *  \param  max_states  Max. number of states
+     */
+    levenshtein_automaton(
+        const std::string & query,
+        size_t              max_k,
+        size_t              max_states = max_states_dflt);
+
+    /** Distance threshold */
+    size_t max_k() const { return m_max_k; }
+
+    /** Number of states */
+    size_t states() const { return m_dist.size(); }
+
+    /**
+     *  \brief  Levenshtein distance of the query from a candidate
+     *
+     *  \param  s       Candidate
+     *  \param  s_size  Candidate length
+     *
+     *  \return Levenshtein distance if <= \c max_k, \c max_k + 1 otherwise
+     */
+    size_t dist(const char * s, size_t s_size) const {
+        state_t state = start;
+
+        for (size_t i = 0; i < s_size; ++i) {
+            state = m_delta[state * m_classes + m_class[(unsigned char)s[i]]];
+            if (dead == state) return m_max_k + 1;
+        }
+
+        return m_dist[state];
+    }
+
+    /**
+     *  \brief  Levenshtein distance of the query from a candidate
+     *
+     *  \param  s  Candidate
+     *
+     *  \return Levenshtein distance if <= \c max_k, \c max_k + 1 otherwise
+     */
+    size_t dist(const std::string & s) const {
+        return dist(s.data(), s.size());
+    }
+
+    /**
+     *  \brief  Check whether candidate is within \c max_k edits
+     *
+     *  \param  s  Candidate
+     *
+     *  \return \c true iff the automaton accepts \c s
+     */
+    bool accepts(const std::string & s) const {
+        return dist(s) <= m_max_k;
+    }
+
+};  // end of class levenshtein_automaton
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__levenshtein_automaton_hxx
@@ -0,0 +1,1041 @@
+#ifndef algorithm__string__myers_miller_hxx
+#define algorithm__string__myers_miller_hxx
+
+/**
+ *  \file
+ *  \brief  Myers-Miller affine gap string alignment
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#include "algorithm/string/hirschberg.hxx"
+#include "algorithm/string/nw_row.hxx"
+#include "algorithm/string/edit_script.hxx"
+#include "algorithm/string/stats.hxx"
+#include "algorithm/parallel/thread_pool.hxx"
+
+#include <string>
+#include <tuple>
+#include <vector>
+#include <stdexcept>
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  Myers-Miller algorithm (affine gap costs)
+ *
+ *  Linear space global alignment with affine gap costs: a gap of
+ *  k characters c_1 ... c_k costs gap_open + del(c_1) + ... + del(c_k)
+ *  (or ins, respectively).  The gap opening cost must not be positive
+ *  (the recurrence below would otherwise re-open gaps already open,
+ *  so the alignment wouldn't be optimal).
+ *  Gotoh's three state score recurrence
+ *  (alignments ending by substitution, deletion or insertion) is used
+ *  in Hirschberg's divide and conquer manner; the division also
+ *  considers deletion gaps spanning the middle row.
+ *
+ *  See E. W. Myers, W. Miller: Optimal alignments in linear space,
+ *  CABIOS 4(1), 1988 and O. Gotoh: An improved algorithm for matching
+ *  biological sequences, J. Mol. Biol. 162, 1982.
+ *
+ *  The interface mirrors \ref hirschberg (the same cost functions,
+ *  workspace and alignment outputs are used).  Like \ref hirschberg,
+ *  small sub-problems are aligned using full score matrices,
+ *  the score matrices may be computed in a band around the diagonal
+ *  only and long alignments may be computed in parallel.
+ *  The vectorised score rows of \ref hirschberg aren't used: the three
+ *  interdependent Gotoh's rows don't fit the prefix-max kernel.
+ *
+ *  \tparam  Del  Deletion gap extension cost function type (char -> int)
+ *  \tparam  Ins  Insertion gap extension cost function type (char -> int)
+ *  \tparam  Sub  Substitution cost function type (char, char -> int)
+ */
+template <class Del, class Ins, class Sub>
+class myers_miller {
+    private:
+
+    int         m_open;  /**< Gap opening cost              */
+    mutable Del m_del;   /**< Deletion cost function        */
+    mutable Ins m_ins;   /**< Insertion cost function       */
+    mutable Sub m_sub;   /**< Substitution cost function    */
+
+    int m_del_max;  /**< Max. deletion cost     */
+    int m_ins_max;  /**< Max. insertion cost    */
+    int m_sub_max;  /**< Max. substitution cost */
+
+    size_t m_par_cutoff;  /**< Parallel computation cutoff    */
+    size_t m_band;        /**< Band width (0 means unbanded)  */
+    size_t m_leaf_cells;  /**< Full score matrices cutoff     */
+
+    /**
+     *  \brief  Upper bound of alignment score
+     *
+     *  See \ref hirschberg; the gap opening cost (which isn't positive)
+     *  is left out.
+     *
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of another string
+     *
+     *  \return Upper bound of the strings alignment score
+     */
+    int score_bound(size_t s1_size, size_t s2_size) const {
+        const int k   = (int)(s1_size < s2_size ? s1_size : s2_size);
+        const int del = m_del_max;
+        const int ins = m_ins_max;
+
+        return impl::max(
+            (int)s1_size * del + (int)s2_size * ins,
+            k * m_sub_max +
+            ((int)s1_size - k) * del + ((int)s2_size - k) * ins);
+    }
+
+    /**
+     *  \brief  Upper bound of scores of paths leaving the band
+     *
+     *  See \ref hirschberg.  Considers the paths leaving the band
+     *  between rows \c i and \c i + 1 by deletion or substitution
+     *  (i.e. those which only need row \c i scores; leaving the band
+     *  by insertion is bounded by the caller once row \c i + 1 is done).
+     *  Alignments ending by deletion or insertion don't score more than
+     *  all the alignments, so \c cc scores are used.
+     *
+     *  \tparam  Rev  Read \c s2 in reverse (reverse sweep)
+     *
+     *  \param  cc       Row \c i scores
+     *  \param  i        Row
+     *  \param  lo       First column of row \c i band
+     *  \param  hi       Last column of row \c i band
+     *  \param  lo_b     First column of row \c i + 1 band
+     *  \param  hi_b     Last column of row \c i + 1 band
+     *  \param  c1       Row \c i + 1 character
+     *  \param  s2       Another string
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of \c s2
+     *
+     *  \return Upper bound of scores of the paths leaving the band
+     */
+    template <bool Rev>
+    int band_exit(
+        const int * cc, size_t i,
+        size_t lo, size_t hi, size_t lo_b, size_t hi_b,
+        char c1, const char * s2, size_t s1_size, size_t s2_size)
+    const {
+        auto s2_j = [&](size_t j) {
+            return Rev ? s2[s2_size - 1 - j] : s2[j];
+        };
+
+        int bound = impl::nw_row_ninf;
+
+        // Right edge (substitution)
+        if (hi_b < s2_size && hi == hi_b)
+            bound = cc[hi] + m_sub(c1, s2_j(hi)) +
+                score_bound(s1_size - i - 1, s2_size - hi - 1);
+
+        // Left edge (deletion or substitution)
+        for (size_t j = lo; j < lo_b && j <= hi; ++j) {
+            int score = cc[j] + m_del(c1);
+            if (j > lo)
+                score = impl::max(score, cc[j - 1] + m_sub(c1, s2_j(j - 1)));
+
+            bound = impl::max(bound,
+                score + score_bound(s1_size - i - 1, s2_size - j));
+        }
+
+        return bound;
+    }
+
+    /**
+     *  \brief  Gotoh's scores (forward or reverse sweep)
+     *
+     *  Computes the last row of scores of all alignments (\c cc)
+     *  and of alignments ending by deletion (\c dd) of \c s1 prefix
+     *  (forward sweep) or of the reversed strings' suffixes (reverse
+     *  sweep).  Only the cells within the band are computed (see
+     *  \ref impl::band_row); the cells next to the band are set
+     *  to -infinity.  Upper bound of scores of paths leaving the band
+     *  is computed, too (see \ref band_exit).
+     *
+     *  \tparam  Rev  Reverse sweep
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s1_div   Length of \c s1 prefix (forward sweep)
+     *                   or start of \c s1 suffix (reverse sweep)
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  tb       Leading (or trailing) deletion gap opening cost
+     *  \param  cc       Scores row (|s2| + 1)
+     *  \param  dd       Deletion scores row (|s2| + 1)
+     *  \param  exit     Band exit score bound
+     */
+    template <bool Rev>
+    void gotoh_sweep(
+        const char * s1, size_t s1_size, size_t s1_div,
+        const char * s2, size_t s2_size,
+        size_t band, int tb, int * cc, int * dd, int & exit)
+    const {
+        ALGORITHM_STATS_TIMER(SWEEP);
+
+        auto s2_j = [&](size_t j) {
+            return Rev ? s2[s2_size - 1 - j] : s2[j];
+        };
+
+        size_t lo, hi;
+        impl::band_row(0, s1_size, s2_size, band, lo, hi);
+
+        // 1st row (insertions only)
+        cc[0] = 0;
+        dd[0] = impl::nw_row_ninf;
+        for (size_t j = 0; j < hi; ++j) {
+            cc[j + 1] = (j ? cc[j] : m_open) + m_ins(s2_j(j));
+            dd[j + 1] = impl::nw_row_ninf;
+        }
+
+        exit = hi < s2_size
+            ? cc[hi] + m_ins(s2_j(hi)) +
+              score_bound(s1_size, s2_size - hi - 1)
+            : impl::nw_row_ninf;
+
+        // Other rows (keeping just one)
+        const size_t rows = Rev ? s1_size - s1_div : s1_div;
+
+        int gap = tb;  // leading (trailing) deletion gap
+        for (size_t i = 0; i < rows; ++i) {
+            const char c1 = Rev ? s1[s1_size - 1 - i] : s1[i];
+
+            size_t lo_b, hi_b;
+            impl::band_row(i + 1, s1_size, s2_size, band, lo_b, hi_b);
+            ALGORITHM_STATS_ADD(cells, hi_b + 1 - lo_b);
+
+            for (size_t j = hi + 1; j <= hi_b; ++j)
+                cc[j] = dd[j] = impl::nw_row_ninf;
+
+            exit = impl::max(exit, band_exit<Rev>(cc,
+                i, lo, hi, lo_b, hi_b, c1, s2, s1_size, s2_size));
+
+            gap += m_del(c1);
+
+            size_t j = lo_b ? lo_b - 1 : 0;   // column left of the band
+            int    s = cc[j];                 // diagonal score
+            int    c = lo_b ? impl::nw_row_ninf : gap;  // left score
+            int    e = impl::nw_row_ninf;     // insertion score
+
+            cc[j] = dd[j] = c;
+
+            for (; j < hi_b; ++j) {
+                const char c2 = s2_j(j);
+
+                e = impl::max(e, c + m_open) + m_ins(c2);
+                dd[j + 1] = impl::max(dd[j + 1], cc[j + 1] + m_open)
+                    + m_del(c1);
+                c = impl::max(dd[j + 1], e, s + m_sub(c1, c2));
+
+                s = cc[j + 1];
+                cc[j + 1] = c;
+            }
+
+            // Right edge (insertion)
+            if (hi_b < s2_size)
+                exit = impl::max(exit,
+                    cc[hi_b] + m_ins(s2_j(hi_b)) +
+                    score_bound(s1_size - i - 1, s2_size - hi_b - 1));
+
+            lo = lo_b;
+            hi = hi_b;
+        }
+    }
+
+    /**
+     *  \brief  Alignment of a single character with a string
+     *
+     *  The character is either substituted for a string character
+     *  (the rest of the string being inserted) or deleted (joining
+     *  the leading or trailing deletion gap, whichever is cheaper).
+     *
+     *  \param  c1       The character
+     *  \param  s2       The string
+     *  \param  s2_size  Length of \c s2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  out      Alignment output
+     */
+    template <class Output>
+    void align_1(
+        char         c1,
+        const char * s2, size_t s2_size,
+        int          tb,
+        int          te,
+        Output     & out)
+    const {
+        int ins_all = m_open;  // insertion of the whole s2
+        for (size_t j = 0; j < s2_size; ++j) ins_all += m_ins(s2[j]);
+
+        // Deletion
+        int    best     = impl::max(tb, te) + m_del(c1) + ins_all;
+        size_t best_pos = s2_size;  // deletion
+
+        // Substitution
+        int ins_pre = 0;  // insertion of s2 prefix (w/o opening)
+        for (size_t j = 0; j < s2_size; ++j) {
+            const int ins_post = ins_all - m_open - ins_pre - m_ins(s2[j]);
+
+            const int score = m_sub(c1, s2[j])
+                + (j ? m_open + ins_pre : 0)
+                + (j + 1 < s2_size ? m_open + ins_post : 0);
+
+            if (score > best) {
+                best     = score;
+                best_pos = j;
+            }
+
+            ins_pre += m_ins(s2[j]);
+        }
+
+        // Write the alignment
+        if (s2_size == best_pos) {
+            if (tb >= te) out.del(c1);
+            for (size_t j = 0; j < s2_size; ++j) out.ins(s2[j]);
+            if (tb <  te) out.del(c1);
+
+            return;
+        }
+
+        for (size_t j = 0; j < best_pos; ++j) out.ins(s2[j]);
+        out.sub(c1, s2[best_pos]);
+        for (size_t j = best_pos + 1; j < s2_size; ++j) out.ins(s2[j]);
+    }
+
+    /**
+     *  \brief  Full score matrices alignment (recursion leaf)
+     *
+     *  Gotoh's alignment with traceback.  The traceback runs from
+     *  the matrices' end, so the alignment is recorded (in the buffer)
+     *  and written in order afterwards.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  out      Alignment output
+     *  \param  buffer   Score buffer (see \ref leaf_size)
+     */
+    template <class Output>
+    void align_matrix(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        int          tb,
+        int          te,
+        Output     & out,
+        int        * buffer)
+    const {
+        ALGORITHM_STATS_TIMER(LEAF);
+        ALGORITHM_STATS_ADD(cells, (s1_size + 1) * (s2_size + 1));
+
+        // Scores of all alignments, those ending by deletion and insertion
+        // of s1 prefix of length i and s2 prefix of length j
+        const size_t row   = s2_size + 1;
+        const size_t cells = (s1_size + 1) * row;
+
+        int * const cc = buffer;
+        int * const dd = buffer + cells;
+        int * const ee = buffer + 2 * cells;
+        int * const ops = buffer + 3 * cells;
+
+        cc[0] = 0;
+        dd[0] = ee[0] = impl::nw_row_ninf;
+        for (size_t j = 1; j <= s2_size; ++j) {
+            cc[j] = ee[j] = (1 < j ? cc[j - 1] : m_open) + m_ins(s2[j - 1]);
+            dd[j] = impl::nw_row_ninf;
+        }
+
+        for (size_t i = 1; i <= s1_size; ++i) {
+            const char c1 = s1[i - 1];
+
+            int * const c_a = cc + (i - 1) * row;  int * const c_b = c_a + row;
+            int * const d_a = dd + (i - 1) * row;  int * const d_b = d_a + row;
+            int * const e_b = ee + i * row;
+
+            c_b[0] = d_b[0] = (1 < i ? c_a[0] : tb) + m_del(c1);
+            e_b[0] = impl::nw_row_ninf;
+
+            for (size_t j = 1; j <= s2_size; ++j) {
+                const char c2 = s2[j - 1];
+
+                e_b[j] = impl::max(e_b[j - 1], c_b[j - 1] + m_open)
+                    + m_ins(c2);
+                d_b[j] = impl::max(d_a[j], c_a[j] + m_open) + m_del(c1);
+                c_b[j] = impl::max(
+                    d_b[j], e_b[j], c_a[j - 1] + m_sub(c1, c2));
+            }
+        }
+
+        // Traceback (the trailing deletion gap may be opened by te)
+        size_t i = s1_size;
+        size_t j = s2_size;
+        size_t n = 0;  // number of operations
+
+        enum { SUB, DEL, INS } state = SUB;
+        if (j && dd[i * row + j] - m_open + te > cc[i * row + j])
+            state = DEL;
+
+        while (i && j) {
+            const size_t ij = i * row + j;
+
+            if (SUB == state) {
+                if (cc[ij] == cc[ij - row - 1] + m_sub(s1[i - 1], s2[j - 1])) {
+                    ops[n++] = 's';
+                    --i; --j;
+                    continue;
+                }
+
+                state = cc[ij] == dd[ij] ? DEL : INS;
+            }
+
+            if (DEL == state) {
+                ops[n++] = 'd';
+                if (!(1 < i && dd[ij] == dd[ij - row] + m_del(s1[i - 1])))
+                    state = SUB;
+                --i;
+            }
+            else {
+                ops[n++] = 'i';
+                if (!(1 < j && ee[ij] == ee[ij - 1] + m_ins(s2[j - 1])))
+                    state = SUB;
+                --j;
+            }
+        }
+
+        for (; i; --i) ops[n++] = 'd';
+        for (; j; --j) ops[n++] = 'i';
+
+        // Write the alignment (in order)
+        while (n) {
+            switch (ops[--n]) {
+                case 's': out.sub(s1[i], s2[j]); ++i; ++j; break;
+                case 'd': out.del(s1[i]);        ++i;      break;
+                case 'i': out.ins(s2[j]);             ++j; break;
+            }
+        }
+    }
+
+    /**
+     *  \brief  Leaf score buffer size
+     *
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of another string
+     *
+     *  \return Number of scores for \ref align_matrix
+     */
+    static size_t leaf_size(size_t s1_size, size_t s2_size) {
+        return 3 * (s1_size + 1) * (s2_size + 1) + s1_size + s2_size;
+    }
+
+    /**
+     *  \brief  Find optimal division
+     *
+     *  \c s1 is divided at |s1| / 2.  The optimal alignment either
+     *  goes through a cell (|s1| / 2, \c s2_div) of the score matrix
+     *  (type 1), or a deletion gap spans over the \c s1 division
+     *  (type 2, i.e. \c s1[|s1| / 2 - 1] and \c s1[|s1| / 2] are deleted).
+     *
+     *  If banded, the division is searched for within the band only
+     *  and the band is widened if necessary, see \ref hirschberg.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1 (>= 2)
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  gap      Division type 2 (deletion gap) flag
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool (optional)
+     *
+     *  \return \c s2 division
+     */
+    size_t split(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        size_t     & band,
+        int          tb,
+        int          te,
+        bool       & gap,
+        int        * buffer,
+        parallel::thread_pool * pool = NULL)
+    const {
+        const size_t s1_div = s1_size / 2;
+
+        for (;;) {
+            // Band covering the whole matrix
+            if (band >= s1_size || band >= s2_size) band = 0;
+
+            size_t lo, hi;
+            impl::band_row(s1_div, s1_size, s2_size, band, lo, hi);
+
+            bool optimal;
+            const size_t s2_div = split(
+                s1, s1_size, s2, s2_size, band, lo, hi, tb, te, gap,
+                buffer, pool, optimal);
+
+            if (optimal) return s2_div;
+
+            band *= 2;
+        }
+    }
+
+    /**
+     *  \brief  Find optimal division within band
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1 (>= 2)
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  lo       First column of the band at |s1| / 2
+     *  \param  hi       Last column of the band at |s1| / 2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  gap      Division type 2 (deletion gap) flag
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool (optional)
+     *  \param  optimal  No path leaving the band scores better
+     *
+     *  \return \c s2 division
+     */
+    size_t split(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        size_t       band,
+        size_t       lo,
+        size_t       hi,
+        int          tb,
+        int          te,
+        bool       & gap,
+        int        * buffer,
+        parallel::thread_pool * pool,
+        bool       & optimal)
+    const {
+        const size_t s1_div = s1_size / 2;
+
+        const size_t s2_size_plus_1 = s2_size + 1;
+        int * cc = buffer + 0 * s2_size_plus_1;
+        int * dd = buffer + 1 * s2_size_plus_1;
+        int * rr = buffer + 2 * s2_size_plus_1;
+        int * ss = buffer + 3 * s2_size_plus_1;
+
+        int exit_l;  // left  band exit score bound
+        int exit_r;  // right band exit score bound
+
+        if (NULL == pool) {
+            gotoh_sweep<false>(s1, s1_size, s1_div, s2, s2_size,
+                band, tb, cc, dd, exit_l);
+            gotoh_sweep<true>(s1, s1_size, s1_div, s2, s2_size,
+                band, te, rr, ss, exit_r);
+        }
+        else {
+            parallel::task_group sweeps(*pool);
+            sweeps.run([&]() {
+                gotoh_sweep<true>(s1, s1_size, s1_div, s2, s2_size,
+                    band, te, rr, ss, exit_r);
+            });
+
+            gotoh_sweep<false>(s1, s1_size, s1_div, s2, s2_size,
+                band, tb, cc, dd, exit_l);
+
+            sweeps.wait();
+        }
+
+        // Type 2 score counts the spanning gap opening twice
+        size_t s2_div = lo;
+        int    s2_div_score = cc[lo] + rr[s2_size - lo];
+        gap = false;
+
+        for (size_t j = lo, l = s2_size - j; j <= hi; ++j, --l) {
+            const int score_1 = cc[j] + rr[l];
+            const int score_2 = dd[j] + ss[l] - m_open;
+
+            if (score_1 > s2_div_score) {
+                s2_div       = j;
+                s2_div_score = score_1;
+                gap          = false;
+            }
+
+            if (score_2 > s2_div_score) {
+                s2_div       = j;
+                s2_div_score = score_2;
+                gap          = true;
+            }
+        }
+
+        optimal = s2_div_score >= impl::max(exit_l, exit_r);
+
+        return s2_div;
+    }
+
+    /**
+     *  \brief  Trivial alignments (recursion bottom)
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  out      Alignment output
+     *
+     *  \return \c true iff the alignment was trivial (and is done)
+     */
+    template <class Output>
+    bool align_trivial(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        int          tb,
+        int          te,
+        Output     & out)
+    const {
+        if (0 == s1_size) {
+            for (size_t j = 0; j < s2_size; ++j) out.ins(s2[j]);
+            return true;
+        }
+
+        if (0 == s2_size) {
+            for (size_t i = 0; i < s1_size; ++i) out.del(s1[i]);
+            return true;
+        }
+
+        if (1 == s1_size) {
+            align_1(s1[0], s2, s2_size, tb, te, out);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     *  \brief  Implementation
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  out      Alignment output
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     */
+    template <class Output>
+    void align_impl(
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size,
+        int          tb,
+        int          te,
+        Output     & out,
+        size_t       band,
+        int        * buffer)
+    const {
+        ALGORITHM_STATS_CALL();
+
+        if (align_trivial(s1, s1_size, s2, s2_size, tb, te, out)) return;
+
+        // Small enough for full score matrices
+        if ((s1_size + 1) * (s2_size + 1) <= m_leaf_cells) {
+            align_matrix(s1, s1_size, s2, s2_size, tb, te, out, buffer);
+            return;
+        }
+
+        const size_t s1_div = s1_size / 2;
+
+        bool gap;
+        const size_t s2_div = split(
+            s1, s1_size, s2, s2_size, band, tb, te, gap, buffer);
+
+        // Divide and conquer (the score buffer is free for reuse)
+        if (gap) {
+            align_impl(s1, s1_div - 1, s2, s2_div, tb, 0, out, band, buffer);
+            out.del(s1[s1_div - 1]);
+            out.del(s1[s1_div]);
+            align_impl(
+                s1 + s1_div + 1, s1_size - s1_div - 1,
+                s2 + s2_div, s2_size - s2_div, 0, te, out, band, buffer);
+        }
+        else {
+            align_impl(s1, s1_div, s2, s2_div, tb, m_open, out, band,
+                buffer);
+            align_impl(
+                s1 + s1_div, s1_size - s1_div,
+                s2 + s2_div, s2_size - s2_div, m_open, te, out, band,
+                buffer);
+        }
+    }
+
+    /**
+     *  \brief  Implementation (parallel)
+     *
+     *  See \ref hirschberg parallel implementation.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  tb       Leading deletion gap opening cost
+     *  \param  te       Trailing deletion gap opening cost
+     *  \param  out      Alignment output
+     *  \param  band     Band width (0 means unbanded)
+     *  \param  buffer   Score buffer (see \ref workspace_size)
+     *  \param  pool     Thread pool
+     */
+    template <class Output>
+    void align_parallel(
+        const char            * s1, size_t s1_size,
+        const char            * s2, size_t s2_size,
+        int                     tb,
+        int                     te,
+        Output                & out,
+        size_t                  band,
+        int                   * buffer,
+        parallel::thread_pool & pool)
+    const {
+        // Serial below cutoff (or full score matrices)
+        if (s1_size * s2_size < m_par_cutoff ||
+            (s1_size + 1) * (s2_size + 1) <= m_leaf_cells)
+        {
+            align_impl(s1, s1_size, s2, s2_size, tb, te, out, band, buffer);
+            return;
+        }
+
+        ALGORITHM_STATS_CALL();
+
+        if (align_trivial(s1, s1_size, s2, s2_size, tb, te, out)) return;
+
+        const size_t s1_div = s1_size / 2;
+
+        bool gap;
+        const size_t s2_div = split(
+            s1, s1_size, s2, s2_size, band, tb, te, gap, buffer, &pool);
+
+        // Divide and conquer
+        const size_t s1_l_size = gap ? s1_div - 1 : s1_div;
+        const size_t s1_r_div  = gap ? s1_div + 1 : s1_div;
+        const char * s1_r      = s1 + s1_r_div;
+        const char * s2_r      = s2 + s2_div;
+        const size_t s1_r_size = s1_size - s1_r_div;
+        const size_t s2_r_size = s2_size - s2_div;
+        const int    gap_open  = gap ? 0 : m_open;
+
+        impl::alignment_buffer right;
+        parallel::task_group   halves(pool);
+        halves.run([&]() {
+            std::vector<int> right_buffer(
+                workspace_size(s1_r_size, s2_r_size));
+            ALGORITHM_STATS_ADD(bytes, right_buffer.size() * sizeof(int));
+
+            align_parallel(s1_r, s1_r_size, s2_r, s2_r_size, gap_open, te,
+                right, band, right_buffer.data(), pool);
+        });
+
+        align_parallel(s1, s1_l_size, s2, s2_div, tb, gap_open,
+            out, band, buffer, pool);
+
+        if (gap) {
+            out.del(s1[s1_div - 1]);
+            out.del(s1[s1_div]);
+        }
+
+        halves.wait();
+        right.replay(out);
+    }
+
+    /**
+     *  \brief  Padded strings alignment
+     *
+     *  \param  s1    A string
+     *  \param  s2    Another string
+     *  \param  ws    Workspace
+     *  \param  pool  Thread pool (optional)
+     *
+     *  \return String alignment
+     */
+    std::tuple<std::string, std::string> align_padded(
+        const std::string     & s1,
+        const std::string     & s2,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool * pool)
+    const {
+        const size_t s1_size = s1.size();
+        const size_t s2_size = s2.size();
+
+        // Alignment length is at most |s1| + |s2|
+        std::tuple<std::string, std::string> result;
+        std::string & r1 = std::get<0>(result);
+        std::string & r2 = std::get<1>(result);
+        r1.resize(s1_size + s2_size);
+        r2.resize(s1_size + s2_size);
+
+        padded_alignment out(&r1[0], &r2[0]);
+        if (NULL == pool)
+            align(s1.data(), s1_size, s2.data(), s2_size, out, ws);
+        else
+            align(s1.data(), s1_size, s2.data(), s2_size, out, ws, *pool);
+
+        r1.resize(out.size());
+        r2.resize(out.size());
+
+        return result;
+    }
+
+    public:
+
+    /** Default parallel computation cutoff (|s1| * |s2|) */
+    static constexpr size_t parallel_cutoff_dflt = 1 << 22;
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  open  Gap opening cost (must not be positive)
+     *  \param  del   Deletion (gap extension) cost function
+     *  \param  ins   Insertion (gap extension) cost function
+     *  \param  sub   Substitution cost function
+     *
+     *  \throw std::invalid_argument if \c open is positive
+     */
+    myers_miller(int open, Del del, Ins ins, Sub sub):
+        m_open(open),
+        m_del(del),
+        m_ins(ins),
+        m_sub(sub),
+        m_par_cutoff(parallel_cutoff_dflt),
+        m_band(0),
+        m_leaf_cells(impl::cache_scores() / 3)
+    {
+        if (open > 0)
+            throw std::invalid_argument(
+                "myers_miller: positive gap opening cost");
+
+        impl::max_costs(m_del, m_ins, m_sub, m_del_max, m_ins_max, m_sub_max,
+            impl::is_const_cost<Del, Ins, Sub>());
+    }
+
+    typedef std::tuple<std::string, std::string> return_t;
+
+    /**
+     *  \brief  Set parallel computation cutoff
+     *
+     *  Subproblems with |s1| * |s2| below the cutoff are computed serially.
+     *
+     *  \param  cutoff  Cutoff
+     */
+    void parallel_cutoff(size_t cutoff) { m_par_cutoff = cutoff; }
+
+    /**
+     *  \brief  Set band width (banded alignment)
+     *
+     *  See \ref hirschberg::band.  The band is widened automatically
+     *  if necessary, so the alignment is optimal regardless of the band
+     *  width.
+     *
+     *  \param  band  Band width (0 means unbanded, which is the default)
+     */
+    void band(size_t band) { m_band = band; }
+
+    /**
+     *  \brief  Set full score matrices cutoff
+     *
+     *  Sub-problems with (|s1| + 1) * (|s2| + 1) up to the cutoff are
+     *  aligned using full score matrices (3 of them) with traceback
+     *  instead of further recursion.  By default, the matrices fit half
+     *  of the CPU L2 cache.
+     *
+     *  \param  cells  Cutoff (0 means that the recursion goes all the way
+     *                 down to single characters)
+     */
+    void leaf_cells(size_t cells) { m_leaf_cells = cells; }
+
+    /**
+     *  \brief  Score buffer size needed for strings alignment
+     *
+     *  \param  s1_size  Length of a string
+     *  \param  s2_size  Length of another string
+     *
+     *  \return Number of scores
+     */
+    size_t workspace_size(size_t s1_size, size_t s2_size) const {
+        const size_t matrix = (s1_size + 1) * (s2_size + 1);
+        const size_t leaf   = matrix < m_leaf_cells
+            ? leaf_size(s1_size, s2_size)
+            : 4 * m_leaf_cells;  // bounds leaf_size of sub-problems
+
+        return impl::max(4 * (s2_size + 1), leaf);
+    }
+
+    /**
+     *  \brief  Implementation (string views, alignment output)
+     *
+     *  See \ref hirschberg::align.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  ws       Workspace
+     */
+    template <class Output>
+    void align(
+        const char           * s1, size_t s1_size,
+        const char           * s2, size_t s2_size,
+        Output               & out,
+        hirschberg_workspace & ws)
+    const {
+        ALGORITHM_STATS_TIMER(ALIGN);
+
+        align_impl(s1, s1_size, s2, s2_size, m_open, m_open, out, m_band,
+            ws.scores(workspace_size(s1_size, s2_size)));
+    }
+
+    /**
+     *  \brief  Implementation (string views, alignment output, parallel)
+     *
+     *  See \ref hirschberg::align.
+     *
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     *  \param  out      Alignment output
+     *  \param  ws       Workspace
+     *  \param  pool     Thread pool
+     */
+    template <class Output>
+    void align(
+        const char            * s1, size_t s1_size,
+        const char            * s2, size_t s2_size,
+        Output                & out,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool & pool)
+    const {
+        ALGORITHM_STATS_TIMER(ALIGN);
+
+        align_parallel(s1, s1_size, s2, s2_size, m_open, m_open, out, m_band,
+            ws.scores(workspace_size(s1_size, s2_size)), pool);
+    }
+
+    /**
+     *  \brief  Implementation (reusable workspace)
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *  \param  ws  Workspace
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string    & s1,
+        const std::string    & s2,
+        hirschberg_workspace & ws)
+    const {
+        return align_padded(s1, s2, ws, NULL);
+    }
+
+    /**
+     *  \brief  Implementation (reusable workspace, parallel)
+     *
+     *  \param  s1    A string
+     *  \param  s2    Another string
+     *  \param  ws    Workspace
+     *  \param  pool  Thread pool
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string     & s1,
+        const std::string     & s2,
+        hirschberg_workspace  & ws,
+        parallel::thread_pool & pool)
+    const {
+        return align_padded(s1, s2, ws, &pool);
+    }
+
+    /**
+     *  \brief  Implementation
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *
+     *  \return String alignment
+     */
+    return_t operator () (
+        const std::string & s1,
+        const std::string & s2)
+    const {
+        hirschberg_workspace ws;
+        return (*this)(s1, s2, ws);
+    }
+
+    /**
+     *  \brief  Edit script of strings alignment
+     *
+     *  \param  s1  A string
+     *  \param  s2  Another string
+     *  \param  ws  Workspace
+     *
+     *  \return Edit script
+     */
+    edit_script script(
+        const std::string    & s1,
+        const std::string    & s2,
+        hirschberg_workspace & ws)
+    const {
+        edit_script out;
+        align(s1.data(), s1.size(), s2.data(), s2.size(), out, ws);
+
+        return out;
+    }
+
+};  // end of template class myers_miller
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__myers_miller_hxx
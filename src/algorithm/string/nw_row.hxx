@@ -0,0 +1,313 @@
+#ifndef algorithm__string__nw_row_hxx
+#define algorithm__string__nw_row_hxx
+
+/**
+ *  \file
+ *  \brief  Needleman-Wunsch score row kernels for constant costs
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALGORITHM_STRING_NW_ROW_X86
+#include <immintrin.h>
+#endif
+
+
+namespace algorithm {
+namespace string {
+
+namespace impl {
+
+/** Score low enough not to be selected by max (yet without overflows) */
+static constexpr int nw_row_ninf = -(1 << 29);
+
+
+/**
+ *  \brief  Needleman-Wunsch score row (constant costs, scalar)
+ *
+ *  Computes row \c b of the Needleman-Wunsch score matrix from
+ *  the previous row \c a for character \c c:
+ *
+ *    b[j + 1] = max(a[j] + sub(c, s_j), a[j + 1] + del, b[j] + ins)
+ *
+ *  where s_j is \c s[j] (or \c s[n - 1 - j] if \c Rev is \c true).
+ *  \c b[0] must be set by the caller.
+ *
+ *  \tparam  Rev  Read \c s in reverse
+ *
+ *  \param  a    Previous row
+ *  \param  b    Computed row
+ *  \param  c    Character
+ *  \param  s    String
+ *  \param  j    First column to compute
+ *  \param  n    Length of \c s
+ *  \param  eql  Character match cost
+ *  \param  sub  Substitution cost
+ *  \param  del  Deletion cost
+ *  \param  ins  Insertion cost
+ */
+template <bool Rev>
+inline void nw_row_scalar(
+    const int * a, int * b, char c, const char * s, size_t j, size_t n,
+    int eql, int sub, int del, int ins)
+{
+    for (; j < n; ++j) {
+        const char s_j  = Rev ? s[n - 1 - j] : s[j];
+        const int  diag = a[j] + (c == s_j ? eql : sub);
+        const int  up   = a[j + 1] + del;
+        const int  left = b[j] + ins;
+
+        const int best = diag > up ? diag : up;
+        b[j + 1] = best > left ? best : left;
+    }
+}
+
+#ifdef ALGORITHM_STRING_NW_ROW_X86
+
+
+/**
+ *  \brief  Insertion chain resolution (4 cells, SSE4.1)
+ *
+ *  Given the diagonal/vertical maxima \c t of 4 consecutive cells
+ *  and the previous (already final) cell score broadcast in \c carry,
+ *  resolves the horizontal dependency
+ *
+ *    b[j] = max(t[j], b[j - 1] + ins)
+ *
+ *  by a log-step prefix maximum scan (i.e. without a sequential chain).
+ *
+ *  \param  t      Diagonal/vertical maxima
+ *  \param  carry  Previous cell score (in all lanes)
+ *  \param  ins    Insertion cost (in all lanes)
+ *  \param  ins2   Double insertion cost (in all lanes)
+ *  \param  ins_k  (k + 1) * insertion cost (in lane k)
+ *
+ *  \return Final scores
+ */
+__attribute__((target("sse4.1")))
+inline __m128i nw_row_scan_sse41(
+    __m128i t, __m128i carry, __m128i ins, __m128i ins2, __m128i ins_k)
+{
+    const __m128i ninf = _mm_set1_epi32(nw_row_ninf);
+
+    // Lane k := max(t[k], t[k - 1] + ins, ..., t[0] + k * ins)
+    t = _mm_max_epi32(t, _mm_add_epi32(_mm_alignr_epi8(t, ninf, 12), ins));
+    t = _mm_max_epi32(t, _mm_add_epi32(_mm_alignr_epi8(t, ninf, 8), ins2));
+
+    // Previous cell contribution
+    return _mm_max_epi32(t, _mm_add_epi32(carry, ins_k));
+}
+
+
+/**
+ *  \brief  Needleman-Wunsch score row (constant costs, SSE4.1)
+ *
+ *  Processes 4 cells at a time, see \ref nw_row_scalar.
+ *
+ *  \return Columns processed (the rest shall be processed by scalar code)
+ */
+template <bool Rev>
+__attribute__((target("sse4.1")))
+size_t nw_row_sse41(
+    const int * a, int * b, char c, const char * s, size_t n,
+    int eql, int sub, int del, int ins)
+{
+    const __m128i v_c   = _mm_set1_epi32((unsigned char)c);
+    const __m128i v_eql = _mm_set1_epi32(eql);
+    const __m128i v_sub = _mm_set1_epi32(sub);
+    const __m128i v_del = _mm_set1_epi32(del);
+    const __m128i v_ins = _mm_set1_epi32(ins);
+    const __m128i v_in2 = _mm_set1_epi32(2 * ins);
+    const __m128i v_ink = _mm_set_epi32(4 * ins, 3 * ins, 2 * ins, ins);
+    const __m128i v_rev = _mm_set_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 0, 1, 2, 3);
+
+    __m128i carry = _mm_set1_epi32(b[0]);
+
+    size_t j = 0;
+    for (; j + 4 <= n; j += 4) {
+        int chars;
+        ::memcpy(&chars, Rev ? s + n - 4 - j : s + j, sizeof(chars));
+
+        __m128i v_s = _mm_cvtsi32_si128(chars);
+        if (Rev) v_s = _mm_shuffle_epi8(v_s, v_rev);
+        v_s = _mm_cvtepu8_epi32(v_s);
+
+        const __m128i cost = _mm_blendv_epi8(
+            v_sub, v_eql, _mm_cmpeq_epi32(v_s, v_c));
+
+        const __m128i diag = _mm_add_epi32(
+            _mm_loadu_si128((const __m128i *)(a + j)), cost);
+        const __m128i up   = _mm_add_epi32(
+            _mm_loadu_si128((const __m128i *)(a + j + 1)), v_del);
+
+        const __m128i row = nw_row_scan_sse41(
+            _mm_max_epi32(diag, up), carry, v_ins, v_in2, v_ink);
+
+        _mm_storeu_si128((__m128i *)(b + j + 1), row);
+        carry = _mm_shuffle_epi32(row, 0xff);
+    }
+
+    return j;
+}
+
+
+/**
+ *  \brief  Needleman-Wunsch score row (constant costs, AVX2)
+ *
+ *  Processes 8 cells at a time, see \ref nw_row_scalar.
+ *
+ *  \return Columns processed (the rest shall be processed by scalar code)
+ */
+template <bool Rev>
+__attribute__((target("avx2")))
+size_t nw_row_avx2(
+    const int * a, int * b, char c, const char * s, size_t n,
+    int eql, int sub, int del, int ins)
+{
+    const __m256i v_c   = _mm256_set1_epi32((unsigned char)c);
+    const __m256i v_eql = _mm256_set1_epi32(eql);
+    const __m256i v_sub = _mm256_set1_epi32(sub);
+    const __m256i v_del = _mm256_set1_epi32(del);
+    const __m128i v_ins = _mm_set1_epi32(ins);
+    const __m128i v_in2 = _mm_set1_epi32(2 * ins);
+    const __m128i v_ink = _mm_set_epi32(4 * ins, 3 * ins, 2 * ins, ins);
+    const __m128i v_rev = _mm_set_epi8(
+        15, 14, 13, 12, 11, 10, 9, 8, 0, 1, 2, 3, 4, 5, 6, 7);
+
+    __m128i carry = _mm_set1_epi32(b[0]);
+
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m128i v_s8 = _mm_loadl_epi64(
+            (const __m128i *)(Rev ? s + n - 8 - j : s + j));
+        if (Rev) v_s8 = _mm_shuffle_epi8(v_s8, v_rev);
+
+        const __m256i v_s  = _mm256_cvtepu8_epi32(v_s8);
+        const __m256i cost = _mm256_blendv_epi8(
+            v_sub, v_eql, _mm256_cmpeq_epi32(v_s, v_c));
+
+        const __m256i diag = _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i *)(a + j)), cost);
+        const __m256i up   = _mm256_add_epi32(
+            _mm256_loadu_si256((const __m256i *)(a + j + 1)), v_del);
+
+        const __m256i t = _mm256_max_epi32(diag, up);
+
+        // The insertion chain is resolved per 128 bit lane
+        const __m128i lo = nw_row_scan_sse41(
+            _mm256_castsi256_si128(t), carry, v_ins, v_in2, v_ink);
+        carry = _mm_shuffle_epi32(lo, 0xff);
+
+        const __m128i hi = nw_row_scan_sse41(
+            _mm256_extracti128_si256(t, 1), carry, v_ins, v_in2, v_ink);
+        carry = _mm_shuffle_epi32(hi, 0xff);
+
+        _mm_storeu_si128((__m128i *)(b + j + 1), lo);
+        _mm_storeu_si128((__m128i *)(b + j + 5), hi);
+    }
+
+    return j;
+}
+
+
+/** Available SIMD instruction set level */
+enum nw_row_isa {
+    NW_ROW_SCALAR = 0,  /**< No SIMD     */
+    NW_ROW_SSE41,       /**< SSE4.1      */
+    NW_ROW_AVX2,        /**< AVX2        */
+};  // end of enum nw_row_isa
+
+
+/** Resolve SIMD instruction set level (once, at runtime) */
+inline nw_row_isa nw_row_resolve_isa() {
+    static const nw_row_isa isa = []() -> nw_row_isa {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))   return NW_ROW_AVX2;
+        if (__builtin_cpu_supports("sse4.1")) return NW_ROW_SSE41;
+
+        return NW_ROW_SCALAR;
+    }();
+
+    return isa;
+}
+
+#endif  // end of #ifdef ALGORITHM_STRING_NW_ROW_X86
+
+
+/**
+ *  \brief  Needleman-Wunsch score row (constant costs)
+ *
+ *  Picks the best available kernel at runtime, see \ref nw_row_scalar.
+ *  The computed scores are identical for all the kernels.
+ */
+template <bool Rev>
+inline void nw_row(
+    const int * a, int * b, char c, const char * s, size_t n,
+    int eql, int sub, int del, int ins)
+{
+    size_t j = 0;
+
+#ifdef ALGORITHM_STRING_NW_ROW_X86
+    switch (nw_row_resolve_isa()) {
+        case NW_ROW_AVX2:
+            j = nw_row_avx2<Rev>(a, b, c, s, n, eql, sub, del, ins);
+            break;
+
+        case NW_ROW_SSE41:
+            j = nw_row_sse41<Rev>(a, b, c, s, n, eql, sub, del, ins);
+            break;
+
+        case NW_ROW_SCALAR:
+            break;
+    }
+#endif  // end of #ifdef ALGORITHM_STRING_NW_ROW_X86
+
+    nw_row_scalar<Rev>(a, b, c, s, j, n, eql, sub, del, ins);
+}
+
+}  // end of namespace impl
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__nw_row_hxx
@@ -0,0 +1,446 @@
+/**
+ *  \file
+ *  \brief  Threshold similarity join of string sets
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+
+#include "algorithm/string/simi_join.hxx"
+#include "algorithm/string/levenshtein.hxx"
+
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
+#include <cmath>
+
+
+namespace algorithm {
+namespace string {
+
+namespace impl {
+
+/** Probes processed by a parallel task */
+static constexpr size_t simi_join_chunk = 64;
+
+
+/**
+ *  \brief  Check the number of shared ranks
+ *
+ *  The ranks are merged until it's clear whether at least \c min
+ *  of them are shared.
+ *
+ *  \param  r1      Ranks (sorted)
+ *  \param  r1_end  Ranks end
+ *  \param  r2      Other ranks (sorted)
+ *  \param  r2_end  Other ranks end
+ *  \param  min     Min. number of shared ranks
+ *
+ *  \return \c true iff at least \c min ranks are shared
+ */
+static bool shared_ranks(
+    const uint32_t * r1, const uint32_t * r1_end,
+    const uint32_t * r2, const uint32_t * r2_end,
+    size_t min)
+{
+    size_t shared = 0;
+
+    while (r1 < r1_end && r2 < r2_end) {
+        if (shared >= min) return true;
+
+        // Not enough ranks left
+        const size_t left1 = r1_end - r1;
+        const size_t left2 = r2_end - r2;
+        if (shared + (left1 < left2 ? left1 : left2) < min) return false;
+
+        if      (*r1 < *r2) ++r1;
+        else if (*r2 < *r1) ++r2;
+        else {
+            ++shared;
+            ++r1; ++r2;
+        }
+    }
+
+    return shared >= min;
+}
+
+}  // end of namespace impl
+
+
+/** Candidates' scratch */
+struct simi_join::scratch {
+    std::vector<uint64_t> grams;   /**< Probe q-grams                   */
+    std::vector<uint32_t> ranks;   /**< Probe (indexed) q-gram ranks    */
+    std::vector<uint64_t> stamps;  /**< Last probe of candidates        */
+    std::vector<uint32_t> cands;   /**< Candidates                      */
+    uint64_t              stamp;   /**< Current probe stamp             */
+
+    scratch(): stamp(0) {}
+};  // end of struct simi_join::scratch
+
+
+size_t simi_join::max_dist(size_t size) const {
+    // See thresholded levenshtein_simi
+    const double max_k = (1.0 - m_min_simi) * size + 1e-9;
+    return max_k < size ? (size_t)max_k : size;
+}
+
+
+long simi_join::min_shared(size_t size) const {
+    // Shared q-grams >= L - q + 1 - k * q >= L * (1 - q * (1 - min_simi))
+    // - q + 1 (up to rounding), which only grows with L if q * (1 -
+    // min_simi) < 1
+    const double slope = 1.0 - m_q * (1.0 - m_min_simi);
+    if (slope <= 0.0) return 0;
+
+    const double min = size * slope - m_q + 1 - m_q * 1e-9;
+    return (long)std::ceil(min - 1e-6);
+}
+
+
+void simi_join::qgrams(
+    const char * str, size_t size,
+    std::vector<uint64_t> & grams) const
+{
+    grams.clear();
+    if (size < m_q) return;
+
+    uint64_t gram = 0;
+    const uint64_t mask = 8 == m_q
+        ? ~(uint64_t)0
+        : ((uint64_t)1 << (8 * m_q)) - 1;
+
+    for (size_t i = 0; i < size; ++i) {
+        gram = ((gram << 8) | (unsigned char)str[i]) & mask;
+        if (i + 1 >= m_q) grams.push_back(gram);
+    }
+
+    std::sort(grams.begin(), grams.end());
+}
+
+
+simi_join::simi_join(
+    const std::vector<std::string> & strings,
+    double                           min_simi,
+    size_t                           q)
+:
+    m_strings(strings),
+    m_min_simi(min_simi),
+    m_q(q)
+{
+    if (!(0.0 <= min_simi && min_simi <= 1.0))
+        throw std::invalid_argument(
+            "simi_join: similarity threshold out of [0, 1]");
+
+    if (q < 1 || q > 8)
+        throw std::invalid_argument("simi_join: q-gram length out of [1, 8]");
+
+    if (strings.size() > UINT32_MAX)
+        throw std::invalid_argument("simi_join: too many strings");
+
+    const size_t n = strings.size();
+    std::vector<uint64_t> grams;
+
+    // Count q-gram occurrences (the n-th occurrence of a q-gram in
+    // a string is a distinct token, so that the sets overlap is
+    // the q-gram multisets overlap)
+    m_tokens_at.resize(n + 1);
+    m_tokens_at[0] = 0;
+
+    for (size_t i = 0; i < n; ++i) {
+        qgrams(strings[i].data(), strings[i].size(), grams);
+
+        for (size_t k = 0, occ = 0; k < grams.size(); ++k) {
+            occ = k > 0 && grams[k] == grams[k - 1] ? occ + 1 : 0;
+
+            auto & freq = m_ranks[grams[k]];
+            if (freq.size() <= occ) freq.resize(occ + 1, 0);
+            ++freq[occ];
+        }
+
+        m_tokens_at[i + 1] = m_tokens_at[i] + grams.size();
+    }
+
+    if (m_tokens_at[n] > UINT32_MAX)
+        throw std::invalid_argument("simi_join: too many q-grams");
+
+    // Global order of tokens: rare first
+    struct token {
+        uint32_t   freq;  /**< Frequency               */
+        uint64_t   gram;  /**< q-gram                  */
+        uint32_t * rank;  /**< Rank (in m_ranks)       */
+
+        bool operator < (const token & rarg) const {
+            return freq != rarg.freq ? freq < rarg.freq : gram < rarg.gram;
+        }
+    };  // end of struct token
+
+    std::vector<token> order;
+    for (auto & ranks: m_ranks)
+        for (auto & freq: ranks.second)
+            order.push_back(token{ freq, ranks.first, &freq });
+
+    std::stable_sort(order.begin(), order.end());
+
+    for (size_t r = 0; r < order.size(); ++r)
+        *order[r].rank = r;
+
+    // Strings' token ranks (sorted)
+    m_tokens.resize(m_tokens_at[n]);
+
+    for (size_t i = 0; i < n; ++i) {
+        qgrams(strings[i].data(), strings[i].size(), grams);
+
+        uint32_t * ranks = m_tokens.data() + m_tokens_at[i];
+        for (size_t k = 0, occ = 0; k < grams.size(); ++k) {
+            occ = k > 0 && grams[k] == grams[k - 1] ? occ + 1 : 0;
+            ranks[k] = m_ranks[grams[k]][occ];
+        }
+
+        std::sort(ranks, ranks + grams.size());
+    }
+
+    // Inverted index of prefixes
+    m_postings_at.assign(order.size() + 1, 0);
+
+    for (size_t i = 0; i < n; ++i) {
+        const long t = min_shared(strings[i].size());
+
+        if (t <= 0) {
+            m_unfiltered.push_back(i);
+            continue;
+        }
+
+        const size_t prefix = m_tokens_at[i + 1] - m_tokens_at[i] - t + 1;
+        for (size_t k = 0; k < prefix; ++k)
+            ++m_postings_at[m_tokens[m_tokens_at[i] + k] + 1];
+    }
+
+    for (size_t r = 0; r < order.size(); ++r)
+        m_postings_at[r + 1] += m_postings_at[r];
+
+    m_postings.resize(m_postings_at[order.size()]);
+    std::vector<size_t> fill(m_postings_at.begin(), m_postings_at.end() - 1);
+
+    for (size_t i = 0; i < n; ++i) {
+        const long t = min_shared(strings[i].size());
+        if (t <= 0) continue;
+
+        const size_t prefix = m_tokens_at[i + 1] - m_tokens_at[i] - t + 1;
+        for (size_t k = 0; k < prefix; ++k)
+            m_postings[fill[m_tokens[m_tokens_at[i] + k]]++] = i;
+    }
+
+    // Strings by length (for the length filter)
+    auto shorter = [&strings](uint32_t i, uint32_t j) {
+        return strings[i].size() < strings[j].size();
+    };
+
+    m_by_size.resize(n);
+    for (size_t i = 0; i < n; ++i) m_by_size[i] = i;
+
+    std::stable_sort(m_by_size.begin(), m_by_size.end(), shorter);
+    std::stable_sort(m_unfiltered.begin(), m_unfiltered.end(), shorter);
+}
+
+
+void simi_join::probe(
+    const std::vector<std::string> & probes,
+    size_t begin, size_t end,
+    bool                 self,
+    const output_t     & out,
+    std::mutex         * out_mutex) const
+{
+    static thread_local scratch scr;
+
+    if (scr.stamps.size() < m_strings.size())
+        scr.stamps.resize(m_strings.size(), 0);
+
+    for (size_t p = begin; p < end; ++p) {
+        const std::string & s1      = probes[p];
+        const size_t        s1_size = s1.size();
+
+        // Length filter: the shorter string has at least min_simi
+        // of the longer one's length
+        const double size_lo = m_min_simi * s1_size - 1e-9;
+        const double size_hi = m_min_simi > 0.0
+            ? (s1_size + 1e-9) / m_min_simi
+            : (double)SIZE_MAX;
+
+        // Probe token ranks (those not in the index can't be shared)
+        qgrams(s1.data(), s1_size, scr.grams);
+
+        scr.ranks.clear();
+        size_t unknown = 0;
+
+        for (size_t k = 0, occ = 0; k < scr.grams.size(); ++k) {
+            occ = k > 0 && scr.grams[k] == scr.grams[k - 1] ? occ + 1 : 0;
+
+            auto ranks = m_ranks.find(scr.grams[k]);
+            if (m_ranks.end() == ranks || ranks->second.size() <= occ)
+                ++unknown;
+            else
+                scr.ranks.push_back(ranks->second[occ]);
+        }
+
+        std::sort(scr.ranks.begin(), scr.ranks.end());
+
+        // Candidates
+        scr.cands.clear();
+        ++scr.stamp;
+
+        auto candidate = [&](uint32_t j) {
+            if (self && j <= p) return;
+
+            const size_t s2_size = m_strings[j].size();
+            if (s2_size < size_lo || s2_size > size_hi) return;
+
+            if (scr.stamp == scr.stamps[j]) return;
+            scr.stamps[j] = scr.stamp;
+
+            scr.cands.push_back(j);
+        };
+
+        auto candidates = [&](const std::vector<uint32_t> & by_size) {
+            auto j = std::lower_bound(by_size.begin(), by_size.end(), size_lo,
+                [this](uint32_t i, double size) {
+                    return m_strings[i].size() < size;
+                });
+
+            for (; j != by_size.end() && m_strings[*j].size() <= size_hi; ++j)
+                candidate(*j);
+        };
+
+        const long t = min_shared(s1_size);
+
+        // q-gram filters don't apply to the probe
+        if (t <= 0)
+            candidates(m_by_size);
+
+        // Probe prefix (the unknown tokens are the rarest, i.e. first)
+        else {
+            const long prefix =
+                (long)scr.grams.size() - t + 1 - (long)unknown;
+
+            for (long k = 0; k < prefix; ++k) {
+                const uint32_t * post     = m_postings.data();
+                const uint32_t * post_end = post + m_postings_at[scr.ranks[k] + 1];
+                post += m_postings_at[scr.ranks[k]];
+
+                // Postings are sorted; self-join only needs those after p
+                if (self) post = std::upper_bound(post, post_end, p);
+
+                for (; post < post_end; ++post) candidate(*post);
+            }
+
+            candidates(m_unfiltered);
+        }
+
+        // Verification
+        for (const uint32_t j: scr.cands) {
+            const std::string & s2      = m_strings[j];
+            const size_t        s2_size = s2.size();
+            const size_t        size    = s1_size > s2_size ? s1_size : s2_size;
+            const size_t        max_k   = max_dist(size);
+
+            // Length filter (exact bound)
+            if ((s1_size > s2_size ? s1_size - s2_size : s2_size - s1_size)
+                > max_k) continue;
+
+            // q-gram count filter
+            const long shared_min = (long)size - m_q + 1 - max_k * m_q;
+            if (shared_min > 0) {
+                const bool shared = impl::shared_ranks(
+                    scr.ranks.data(), scr.ranks.data() + scr.ranks.size(),
+                    m_tokens.data() + m_tokens_at[j],
+                    m_tokens.data() + m_tokens_at[j + 1],
+                    shared_min);
+
+                if (!shared) continue;
+            }
+
+            const size_t dist = levenshtein_dist(
+                s1.data(), s1_size, s2.data(), s2_size, max_k);
+
+            if (dist > max_k) continue;
+
+            const double simi = 0 == size ? 1.0 : 1.0 - (double)dist / size;
+            if (simi < m_min_simi) continue;
+
+            if (NULL == out_mutex)
+                out(p, j, simi);
+            else {
+                std::lock_guard<std::mutex> lock(*out_mutex);
+                out(p, j, simi);
+            }
+        }
+    }
+}
+
+
+void simi_join::join_impl(
+    const std::vector<std::string> & probes,
+    bool                    self,
+    const output_t        & out,
+    parallel::thread_pool * pool) const
+{
+    const size_t n = probes.size();
+
+    if (NULL == pool) {
+        probe(probes, 0, n, self, out, NULL);
+        return;
+    }
+
+    std::mutex          out_mutex;
+    parallel::task_group chunks(*pool);
+
+    for (size_t begin = 0; begin < n; begin += impl::simi_join_chunk) {
+        const size_t end = begin + impl::simi_join_chunk < n
+            ? begin + impl::simi_join_chunk
+            : n;
+
+        chunks.run([&, begin, end]() {
+            probe(probes, begin, end, self, out, &out_mutex);
+        });
+    }
+
+    chunks.wait();
+}
+
+}}  // end of namespaces string algorithm
@@ -0,0 +1,232 @@
+#ifndef algorithm__string__simi_join_hxx
+#define algorithm__string__simi_join_hxx
+
+/**
+ *  \file
+ *  \brief  Threshold similarity join of string sets
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#include "algorithm/parallel/thread_pool.hxx"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  Threshold similarity join
+ *
+ *  Finds all pairs of strings with Levenshtein similarity at least
+ *  \c min_simi (see \ref levenshtein_simi), without computing the whole
+ *  similarity matrix.  The similarity threshold is converted to
+ *  a distance bound for each pair:
+ *
+ *    k = floor((1 - min_simi) * max(|s1|, |s2|))
+ *
+ *  Pairs which can't be within the bound are pruned by
+ *  - length filter: || s1| - |s2| | <= k,
+ *  - q-gram count filter: strings within k edits share at least
+ *    max(|s1|, |s2|) - q + 1 - k * q q-grams,
+ *  - q-gram prefix filter: if the q-grams (occurrences distinguished)
+ *    of both the strings are sorted by the same global order (rare first)
+ *    and they share at least t of them, then their prefixes of length
+ *    |q-grams| - t + 1 share at least one.
+ *  Only the prefixes are kept in the inverted index.
+ *  The surviving candidates are verified by thresholded \ref
+ *  levenshtein_dist.
+ *
+ *  The index is built for one of the sets (the "indexed" strings);
+ *  strings of another set (or the indexed set itself) are the probes.
+ *  If the q-gram filters can't restrict a pair (short strings
+ *  or low threshold), the pair is verified anyway.
+ *
+ *  Indexed strings must exist while the join object is used.
+ *
+ *  See Gravano et al., Approximate String Joins in a Database (Almost)
+ *  for Free, 2001 and Chaudhuri et al., A Primitive Operator for
+ *  Similarity Joins in Data Cleaning, 2006.
+ */
+class simi_join {
+    public:
+
+    /**
+     *  \brief  Join output: probe index, indexed string index, similarity
+     *
+     *  The output isn't called concurrently (even if the join runs
+     *  in parallel); the order of the pairs is unspecified.
+     */
+    typedef std::function<void (size_t, size_t, double)> output_t;
+
+    private:
+
+    /** Candidates' scratch (per thread) */
+    struct scratch;
+
+    const std::vector<std::string> & m_strings;  /**< Indexed strings  */
+    const double m_min_simi;                     /**< Min. similarity  */
+    const size_t m_q;                            /**< q-gram length    */
+
+    /** q-gram occurrence ranks (q-gram -> rank of its n-th occurrence) */
+    std::unordered_map<uint64_t, std::vector<uint32_t> > m_ranks;
+
+    std::vector<uint32_t> m_tokens;      /**< Indexed strings' q-gram ranks */
+    std::vector<size_t>   m_tokens_at;   /**< String q-gram ranks offsets   */
+    std::vector<uint32_t> m_postings;    /**< Inverted index (prefixes)     */
+    std::vector<size_t>   m_postings_at; /**< Rank postings offsets         */
+    std::vector<uint32_t> m_by_size;     /**< Strings sorted by length      */
+    std::vector<uint32_t> m_unfiltered;  /**< Unindexed strings (by length) */
+
+    /**
+     *  \brief  Distance bound
+     *
+     *  \param  size  Length of the longer string of a pair
+     *
+     *  \return Max. distance of similar strings
+     */
+    size_t max_dist(size_t size) const;
+
+    /**
+     *  \brief  Min. number of shared q-grams (lower bound)
+     *
+     *  Lower bound of the q-gram count filter for all the pairs
+     *  in which the longer string is at least \c size long.
+     *
+     *  \param  size  Length of a string
+     *
+     *  \return Min. number of q-grams shared with similar strings
+     *          (non-positive if the filter doesn't apply)
+     */
+    long min_shared(size_t size) const;
+
+    /**
+     *  \brief  String q-grams
+     *
+     *  \param  str   String
+     *  \param  size  Length of the string
+     *  \param  grams q-grams (sorted)
+     */
+    void qgrams(const char * str, size_t size,
+        std::vector<uint64_t> & grams) const;
+
+    /**
+     *  \brief  Join probes with the indexed strings
+     *
+     *  \param  probes     Probe strings
+     *  \param  begin      First probe
+     *  \param  end        Probe end
+     *  \param  self       Self-join (only pairs i < j are reported)
+     *  \param  out        Output
+     *  \param  out_mutex  Output mutex (parallel join)
+     */
+    void probe(
+        const std::vector<std::string> & probes,
+        size_t begin, size_t end,
+        bool                 self,
+        const output_t     & out,
+        std::mutex         * out_mutex) const;
+
+    /** Join implementation (see \ref join, \ref self_join) */
+    void join_impl(
+        const std::vector<std::string> & probes,
+        bool                    self,
+        const output_t        & out,
+        parallel::thread_pool * pool) const;
+
+    public:
+
+    /**
+     *  \brief  Constructor (builds the index)
+     *
+     *  \param  strings   Indexed strings
+     *  \param  min_simi  Min. similarity (in [0, 1])
+     *  \param  q         q-gram length (in [1, 8])
+     */
+    simi_join(
+        const std::vector<std::string> & strings,
+        double                           min_simi,
+        size_t                           q = 2);
+
+    /**
+     *  \brief  Similarity join
+     *
+     *  Reports all pairs (i, j) such that the similarity of \c probes[i]
+     *  and the j-th indexed string is at least \c min_simi.
+     *  If a thread pool is provided, the probes are split to chunks
+     *  processed by the pool threads.
+     *
+     *  \param  probes  Probe strings
+     *  \param  out     Output
+     *  \param  pool    Thread pool (optional)
+     */
+    void join(
+        const std::vector<std::string> & probes,
+        const output_t                 & out,
+        parallel::thread_pool          * pool = NULL) const
+    {
+        join_impl(probes, false, out, pool);
+    }
+
+    /**
+     *  \brief  Self-join
+     *
+     *  Reports all pairs (i, j), i < j of similar indexed strings.
+     *
+     *  \param  out   Output
+     *  \param  pool  Thread pool (optional)
+     */
+    void self_join(
+        const output_t        & out,
+        parallel::thread_pool * pool = NULL) const
+    {
+        join_impl(m_strings, true, out, pool);
+    }
+
+};  // end of class simi_join
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__simi_join_hxx
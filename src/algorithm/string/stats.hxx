@@ -0,0 +1,384 @@
+#ifndef algorithm__string__stats_hxx
+#define algorithm__string__stats_hxx
+
+/**
+ *  \file
+ *  \brief  Hot-path instrumentation counters
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#include "config.hxx"
+
+#include <set>
+#include <mutex>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+
+/**
+ *  \brief  Instrumentation macros
+ *
+ *  The counters are only updated if the library is configured with
+ *  \c ALGORITHM_STATS (see the \c ALGORITHM_STATS CMake option);
+ *  otherwise, the macros expand to nothing and the instrumentation
+ *  has no overhead whatsoever.
+ *
+ *  \c ALGORITHM_STATS_ADD(counter, n)   adds \c n to the thread's \c counter
+ *  \c ALGORITHM_STATS_CALL()            counts a (recursive) call and
+ *                                       tracks recursion depth in scope
+ *  \c ALGORITHM_STATS_TIMER(phase)      adds scope wall time to \c phase
+ */
+#ifdef ALGORITHM_STATS
+
+#define ALGORITHM_STATS_ADD(counter, n) \
+    (::algorithm::string::stats::local().counter += (n))
+
+// Scope-local variable name unique per line
+#define ALGORITHM_STATS_CONCAT_(a, b) a ## b
+#define ALGORITHM_STATS_CONCAT(a, b)  ALGORITHM_STATS_CONCAT_(a, b)
+#define ALGORITHM_STATS_VAR(name) \
+    ALGORITHM_STATS_CONCAT(algorithm_stats_ ## name ## _, __LINE__)
+
+#define ALGORITHM_STATS_CALL() \
+    ::algorithm::string::impl::stats_call ALGORITHM_STATS_VAR(call)
+
+#define ALGORITHM_STATS_TIMER(phase) \
+    ::algorithm::string::impl::stats_timer ALGORITHM_STATS_VAR(timer)( \
+        ::algorithm::string::stats::phase)
+
+#else  // ALGORITHM_STATS not defined
+
+#define ALGORITHM_STATS_ADD(counter, n) ((void)0)
+#define ALGORITHM_STATS_CALL()           ((void)0)
+#define ALGORITHM_STATS_TIMER(phase)     ((void)0)
+
+#endif  // end of #ifdef ALGORITHM_STATS
+
+
+namespace algorithm {
+namespace string {
+
+/**
+ *  \brief  Computation statistics
+ *
+ *  Counters of what the algorithms did.  Each thread has its own
+ *  counters (see \ref local), so they aren't synchronised on hot paths;
+ *  the counters of all the threads (including finished ones) may be
+ *  summed up by \ref total.  Per-call statistics are obtained by
+ *  \ref stats_probe.
+ *
+ *  The counters are only updated if the library is configured with
+ *  \c ALGORITHM_STATS (see \ref enabled).
+ */
+struct stats {
+    /** Instrumented phases */
+    enum phase {
+        DIST = 0,   /**< Levenshtein distance computation         */
+        SWEEP,      /**< Hirschberg's score row sweeps            */
+        LEAF,       /**< Hirschberg's full score matrix leaves    */
+        ALIGN,      /**< Hirschberg's alignment (overall)         */
+        PHASE_CNT,  /**< Number of phases                         */
+    };  // end of enum phase
+
+    /** Counters are updated */
+#ifdef ALGORITHM_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    uint64_t cells;             /**< DP (score matrix) cells computed    */
+    uint64_t calls;             /**< Calls (including recursive ones)    */
+    uint64_t depth;             /**< Max. recursion depth                */
+    uint64_t level;             /**< Current recursion depth             */
+    uint64_t bytes;             /**< Bytes allocated for work buffers    */
+    uint64_t early_exits;       /**< Computations cut off by threshold   */
+    uint64_t time[PHASE_CNT];   /**< Wall time per phase [ns]            */
+
+    /** Constructor (zero counters) */
+    stats() { reset(); }
+
+    /** Zero counters */
+    void reset() {
+        cells = calls = depth = level = bytes = early_exits = 0;
+        for (size_t i = 0; i < PHASE_CNT; ++i) time[i] = 0;
+    }
+
+    /**
+     *  \brief  Add up statistics
+     *
+     *  The max. recursion depth is the max. of both.
+     *
+     *  \param  rarg  Statistics
+     *
+     *  \return \c *this
+     */
+    stats & operator += (const stats & rarg) {
+        cells       += rarg.cells;
+        calls       += rarg.calls;
+        bytes       += rarg.bytes;
+        early_exits += rarg.early_exits;
+        if (rarg.depth > depth) depth = rarg.depth;
+
+        for (size_t i = 0; i < PHASE_CNT; ++i) time[i] += rarg.time[i];
+
+        return *this;
+    }
+
+    /**
+     *  \brief  Statistics difference
+     *
+     *  The max. recursion depth can't be subtracted; it's kept as is.
+     *
+     *  \param  rarg  Earlier statistics
+     *
+     *  \return Statistics since \c rarg
+     */
+    stats operator - (const stats & rarg) const {
+        stats diff(*this);
+
+        diff.cells       -= rarg.cells;
+        diff.calls       -= rarg.calls;
+        diff.bytes       -= rarg.bytes;
+        diff.early_exits -= rarg.early_exits;
+
+        for (size_t i = 0; i < PHASE_CNT; ++i) diff.time[i] -= rarg.time[i];
+
+        return diff;
+    }
+
+    /**
+     *  \brief  Print statistics (one counter per line)
+     *
+     *  \param  out  Output stream
+     */
+    void print(std::ostream & out) const {
+        static const char * const phase_names[PHASE_CNT] = {
+            "dist", "sweep", "leaf", "align",
+        };
+
+        out << "cells: "       << cells       << std::endl
+            << "calls: "       << calls       << std::endl
+            << "depth: "       << depth       << std::endl
+            << "bytes: "       << bytes       << std::endl
+            << "early_exits: " << early_exits << std::endl;
+
+        for (size_t i = 0; i < PHASE_CNT; ++i)
+            out << "time." << phase_names[i] << ": "
+                << (double)time[i] / 1e9 << " s" << std::endl;
+    }
+
+    /**
+     *  \brief  Calling thread's statistics
+     *
+     *  The counters are updated by the instrumentation macros.
+     *
+     *  \return Calling thread's statistics
+     */
+    static stats & local();
+
+    /**
+     *  \brief  All threads' statistics
+     *
+     *  The sum of the counters of all the threads, including
+     *  the finished ones.  Should only be called when the instrumented
+     *  computations are done (the threads' counters aren't synchronised).
+     *
+     *  \return Statistics total
+     */
+    static stats total();
+
+};  // end of struct stats
+
+
+namespace impl {
+
+/** Registry of threads' statistics */
+class stats_registry {
+    private:
+
+    std::mutex              m_mutex;    /**< Operations mutex        */
+    std::set<const stats *> m_live;     /**< Running threads' stats  */
+    stats                   m_retired;  /**< Finished threads' stats */
+
+    public:
+
+    /** The registry */
+    static stats_registry & instance() {
+        static stats_registry registry;
+        return registry;
+    }
+
+    /** Register thread's statistics */
+    void attach(const stats * s) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_live.insert(s);
+    }
+
+    /** Unregister thread's statistics (they are kept in total) */
+    void detach(const stats * s) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_retired += *s;
+        m_live.erase(s);
+    }
+
+    /** Statistics total */
+    stats total() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        stats sum(m_retired);
+        for (auto s: m_live) sum += *s;
+
+        return sum;
+    }
+
+};  // end of class stats_registry
+
+
+/** Thread's statistics (registered for the thread lifetime) */
+class stats_thread: public stats {
+    public:
+
+    stats_thread()  { stats_registry::instance().attach(this); }
+    ~stats_thread() { stats_registry::instance().detach(this); }
+
+};  // end of class stats_thread
+
+
+/** Call counter and recursion depth tracker (scoped) */
+class stats_call {
+    private:
+
+    stats & m_stats;  /**< Thread's statistics */
+
+    public:
+
+    stats_call(): m_stats(stats::local()) {
+        ++m_stats.calls;
+        if (++m_stats.level > m_stats.depth) m_stats.depth = m_stats.level;
+    }
+
+    ~stats_call() { --m_stats.level; }
+
+};  // end of class stats_call
+
+
+/** Phase wall time meter (scoped) */
+class stats_timer {
+    private:
+
+    typedef std::chrono::steady_clock clock;
+
+    stats::phase       m_phase;  /**< Measured phase */
+    clock::time_point  m_start;  /**< Start time     */
+
+    public:
+
+    stats_timer(stats::phase phase):
+        m_phase(phase),
+        m_start(clock::now())
+    {}
+
+    ~stats_timer() {
+        stats::local().time[m_phase] +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                clock::now() - m_start).count();
+    }
+
+};  // end of class stats_timer
+
+}  // end of namespace impl
+
+
+inline stats & stats::local() {
+    static thread_local impl::stats_thread thread_stats;
+    return thread_stats;
+}
+
+
+inline stats stats::total() {
+    local();  // make sure the calling thread's stats are registered
+    return impl::stats_registry::instance().total();
+}
+
+
+/**
+ *  \brief  Per-call statistics
+ *
+ *  Takes a snapshot of the calling thread's statistics on construction;
+ *  \ref get then provides the statistics since.  Note that computations
+ *  done by other threads (e.g. a thread pool's workers) aren't included;
+ *  use \ref stats::total snapshots for parallel computations.
+ */
+class stats_probe {
+    private:
+
+    stats m_start;  /**< Statistics snapshot */
+
+    public:
+
+    /** Constructor (takes the snapshot) */
+    stats_probe(): m_start(stats::local()) {
+        stats & s = stats::local();
+        s.depth = s.level;  // max. depth since the snapshot
+    }
+
+    /** Destructor (restores the thread's max. recursion depth) */
+    ~stats_probe() {
+        stats & s = stats::local();
+        if (m_start.depth > s.depth) s.depth = m_start.depth;
+    }
+
+    /** Statistics since construction */
+    stats get() const {
+        const stats & s = stats::local();
+
+        stats diff = s - m_start;
+        diff.depth = s.depth - m_start.level;
+
+        return diff;
+    }
+
+};  // end of class stats_probe
+
+}}  // end of namespaces string algorithm
+
+#endif  // end of #ifndef algorithm__string__stats_hxx
@@ -0,0 +1,452 @@
+/**
+ *  \file
+ *  \brief  String algorithms benchmark
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "corpus.hxx"
+
+#include "config.hxx"
+
+#include "algorithm/string/levenshtein.hxx"
+#include "algorithm/string/hirschberg.hxx"
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+/** Convert cmd. line argument to non-negative integer */
+static unsigned long long arg2size(const char * arg) {
+    char * err;
+    unsigned long long n = strtoull(arg, &err, 10);
+    if ('\0' != *err || '-' == *arg)
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return n;
+}
+
+
+/** Benchmark case */
+struct bench_case {
+    std::string alphabet;   /**< Alphabet name */
+    size_t      length;     /**< String length */
+    double      edit_rate;  /**< Edit rate */
+    uint64_t    seed;       /**< Corpus seed */
+
+    std::vector<std::string> s1;  /**< Strings */
+    std::vector<std::string> s2;  /**< Mutated strings */
+
+};  // end of struct bench_case
+
+
+/** Benchmark result */
+struct bench_result {
+    char     line[1024];  /**< JSON line (up to the peak RSS) */
+    uint64_t checksum;    /**< Sum of the results             */
+
+};  // end of struct bench_result
+
+
+/**
+ *  \brief  Benchmark run
+ *
+ *  The computation is run for all the case pairs; each call is timed.
+ *  A few first pairs are computed before, to warm up caches and buffers.
+ *
+ *  The result JSON line contains the number of DP matrix cells
+ *  computed per second, call latency percentiles (in ns) and the sum
+ *  of the results (checksum for correctness comparison).
+ *  The peak RSS is added by \ref isolated.
+ *
+ *  \param  name  Algorithm name
+ *  \param  bc    Benchmark case
+ *  \param  fn    Computation (returns result as integer)
+ *
+ *  \return Benchmark result
+ */
+template <class Fn>
+static bench_result run(
+    const char        * name,
+    const bench_case  & bc,
+    Fn                  fn)
+{
+    typedef std::chrono::steady_clock clock;
+
+    const size_t pairs = bc.s1.size();
+
+    // Warm-up
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < pairs && i < 16; ++i)
+        checksum += fn(bc.s1[i], bc.s2[i]);
+
+    // Measurement
+    std::vector<uint64_t> latency(pairs);
+    uint64_t cells = 0;
+
+    checksum = 0;
+    for (size_t i = 0; i < pairs; ++i) {
+        const clock::time_point t0 = clock::now();
+        checksum += fn(bc.s1[i], bc.s2[i]);
+        const clock::time_point t1 = clock::now();
+
+        latency[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            t1 - t0).count();
+
+        cells += (uint64_t)bc.s1[i].size() * bc.s2[i].size();
+    }
+
+    uint64_t total_ns = 0;
+    for (size_t i = 0; i < pairs; ++i) total_ns += latency[i];
+
+    std::sort(latency.begin(), latency.end());
+    auto percentile = [&](unsigned p) -> uint64_t {
+        size_t rank = (pairs * p + 99) / 100;  // nearest rank
+        return latency[rank ? rank - 1 : 0];
+    };
+
+    const double seconds = total_ns * 1e-9;
+
+    bench_result result;
+    result.checksum = checksum;
+    ::snprintf(result.line, sizeof(result.line),
+        "{\"version\":\"%d.%d.%d\",\"algorithm\":\"%s\","
+        "\"alphabet\":\"%s\",\"length\":%zu,\"edit_rate\":%g,"
+        "\"seed\":%llu,\"pairs\":%zu,\"cells\":%llu,\"seconds\":%.6f,"
+        "\"cells_per_second\":%.4g,"
+        "\"latency_ns\":{\"p50\":%llu,\"p90\":%llu,\"p99\":%llu,\"max\":%llu}",
+        ALGORITHM_VERSION_MAJOR, ALGORITHM_VERSION_MINOR,
+        ALGORITHM_VERSION_PATCH,
+        name, bc.alphabet.c_str(), bc.length, bc.edit_rate,
+        (unsigned long long)bc.seed, pairs, (unsigned long long)cells,
+        seconds, seconds > 0 ? cells / seconds : 0.0,
+        (unsigned long long)percentile(50),
+        (unsigned long long)percentile(90),
+        (unsigned long long)percentile(99),
+        (unsigned long long)latency[pairs - 1]);
+
+    return result;
+}
+
+
+/**
+ *  \brief  Run benchmark in a child process
+ *
+ *  Peak resident set size is a process high-water mark; it never
+ *  decreases.  So that it's the case's own peak (corpus and workspace
+ *  included), each case is generated and run by a forked process.
+ *  The result is passed back via pipe and written as a JSON line
+ *  (one per case and algorithm) with the peak RSS (in KiB) added.
+ *
+ *  \param  out    Output stream
+ *  \param  bench  Benchmark (returns \ref bench_result)
+ */
+template <class Bench>
+static void isolated(std::ostream & out, Bench bench) {
+    int fds[2];
+    if (-1 == ::pipe(fds))
+        throw std::runtime_error("Failed to create pipe");
+
+    out.flush();  // don't duplicate buffered output
+
+    const pid_t pid = ::fork();
+    if (-1 == pid) {
+        ::close(fds[0]);
+        ::close(fds[1]);
+        throw std::runtime_error("Failed to fork");
+    }
+
+    // Child: run the benchmark and pass the result
+    if (0 == pid) {
+        ::close(fds[0]);
+
+        int exit_code = 1;
+        try {
+            const bench_result result = bench();
+            if ((ssize_t)sizeof(result) ==
+                ::write(fds[1], &result, sizeof(result)))
+                exit_code = 0;
+        }
+        catch (const std::exception & x) {
+            std::cerr
+                << "Standard exception caught: "
+                << x.what()
+                << std::endl;
+        }
+
+        ::_exit(exit_code);
+    }
+
+    // Parent: collect the result and the child's resource usage
+    ::close(fds[1]);
+
+    bench_result result;
+    size_t size = 0;
+    while (size < sizeof(result)) {
+        const ssize_t rd = ::read(fds[0], (char *)&result + size,
+            sizeof(result) - size);
+        if (rd <= 0) break;
+
+        size += rd;
+    }
+
+    ::close(fds[0]);
+
+    int status;
+    struct rusage usage;
+    if (-1 == ::wait4(pid, &status, 0, &usage) ||
+        !WIFEXITED(status) || 0 != WEXITSTATUS(status) ||
+        sizeof(result) != size)
+    {
+        throw std::runtime_error("Benchmark process failed");
+    }
+
+    out << result.line
+        << ",\"peak_rss_kib\":" << usage.ru_maxrss
+        << ",\"checksum\":" << result.checksum << "}"
+        << std::endl;
+}
+
+
+/**
+ *  \brief  Benchmark case run (in a child process)
+ *
+ *  The case corpus is generated by the child process, too.
+ *
+ *  \param  out    Output stream
+ *  \param  name   Algorithm name
+ *  \param  bc     Benchmark case (without the strings)
+ *  \param  pairs  Number of string pairs
+ *  \param  fn     Computation (returns result as integer)
+ */
+template <class Fn>
+static void bench(
+    std::ostream      & out,
+    const char        * name,
+    const bench_case  & bc,
+    size_t              pairs,
+    Fn                  fn)
+{
+    isolated(out, [&]() {
+        bench_case bc_pairs = bc;
+
+        benchmark::string::corpus corpus(bc.alphabet, bc.seed);
+        bc_pairs.s1.resize(pairs);
+        bc_pairs.s2.resize(pairs);
+        for (size_t i = 0; i < pairs; ++i)
+            corpus.pair(bc.length, bc.edit_rate,
+                bc_pairs.s1[i], bc_pairs.s2[i]);
+
+        return run(name, bc_pairs, fn);
+    });
+}
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    unsigned long long seed      = 1;          // Corpus seed
+    unsigned long long budget    = 100000000;  // Cells per case
+    unsigned long long max_pairs = 10000;      // Max. pairs per case
+    const char *       output    = NULL;       // Output file
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--seed" == opt && opts + 1 < argc)
+            seed = arg2size(argv[++opts]);
+        else if ("--budget" == opt && opts + 1 < argc)
+            budget = arg2size(argv[++opts]);
+        else if ("--max-pairs" == opt && opts + 1 < argc) {
+            max_pairs = arg2size(argv[++opts]);
+            if (0 == max_pairs) opts_ok = false;
+        }
+        else if ("--output" == opt && opts + 1 < argc)
+            output = argv[++opts];
+        else
+            opts_ok = false;
+    }
+
+    // Algorithms
+    static const char * const algorithms[] = {
+        "levenshtein_dist", "levenshtein_simi", "hirschberg" };
+
+    std::vector<std::string> selected(argv + opts, argv + argc);
+    for (size_t i = 0; i < selected.size(); ++i)
+        if (std::find(algorithms, algorithms + 3, selected[i]) ==
+            algorithms + 3) opts_ok = false;
+
+    if (!opts_ok) {
+        std::cerr
+            << "Usage: " << prog << " [options] [algorithm...]"
+            << std::endl
+            << std::endl
+            << "Benchmarks string algorithms (levenshtein_dist,"
+            << std::endl
+            << "levenshtein_simi, hirschberg; all by default)"
+            << std::endl
+            << "on generated corpora of various alphabets, string lengths"
+            << std::endl
+            << "and edit rates.  Results are printed as JSON lines."
+            << std::endl
+            << std::endl
+            << "Options:"
+            << std::endl
+            << "  --seed S         corpus seed (default: " << seed << ")"
+            << std::endl
+            << "  --budget N       DP matrix cells per case "
+               "(default: " << budget << ")"
+            << std::endl
+            << "  --max-pairs N    max. pairs per case "
+               "(default: " << max_pairs << ")"
+            << std::endl
+            << "  --output FILE    write results to FILE"
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    auto enabled = [&](const char * name) {
+        return selected.empty() ||
+            std::find(selected.begin(), selected.end(), name) !=
+            selected.end();
+    };
+
+    std::ofstream file;
+    if (NULL != output) {
+        file.open(output);
+        if (!file.is_open())
+            throw std::runtime_error(
+                std::string("Failed to open ") + output);
+    }
+
+    std::ostream & out = NULL != output ? file : std::cout;
+
+    // Algorithms (Hirschberg with the CLI default costs)
+    typedef algorithm::string::const_cost const_cost;
+    typedef algorithm::string::match_cost match_cost;
+
+    const algorithm::string::hirschberg<const_cost, const_cost, match_cost>
+        hirschberg(const_cost(-2), const_cost(-2), match_cost(2, -1));
+
+    algorithm::string::hirschberg_workspace ws;  // per case (process)
+
+    auto dist = [](const std::string & s1, const std::string & s2) {
+        return (uint64_t)algorithm::string::levenshtein_dist(s1, s2);
+    };
+
+    auto simi = [](const std::string & s1, const std::string & s2) {
+        return (uint64_t)(
+            algorithm::string::levenshtein_simi(s1, s2) * 1000000 + 0.5);
+    };
+
+    auto align = [&](const std::string & s1, const std::string & s2) {
+        return (uint64_t)std::get<0>(hirschberg(s1, s2, ws)).size();
+    };
+
+    // Cases
+    static const char * const alphabets[] = { "dna", "text", "bytes" };
+    static const size_t       lengths[]   = { 16, 64, 256, 1024, 4096 };
+    static const double       rates[]     = { 0.01, 0.1, 0.3 };
+
+    for (const char * alphabet: alphabets)
+    for (size_t length: lengths)
+    for (double rate: rates) {
+        bench_case bc;
+        bc.alphabet  = alphabet;
+        bc.length    = length;
+        bc.edit_rate = rate;
+        bc.seed      = seed;
+
+        size_t pairs = budget / (length * length);
+        if (pairs < 16)        pairs = 16;
+        if (pairs > max_pairs) pairs = max_pairs;
+
+        if (enabled("levenshtein_dist"))
+            bench(out, "levenshtein_dist", bc, pairs, dist);
+
+        if (enabled("levenshtein_simi"))
+            bench(out, "levenshtein_simi", bc, pairs, simi);
+
+        if (enabled("hirschberg"))
+            bench(out, "hirschberg", bc, pairs, align);
+    }
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,159 @@
+/**
+ *  \file
+ *  \brief  String pair corpus generator: CLI
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "corpus.hxx"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+
+/** Convert cmd. line argument to non-negative integer */
+static unsigned long long arg2size(const char * arg) {
+    char * err;
+    unsigned long long n = strtoull(arg, &err, 10);
+    if ('\0' != *err || '-' == *arg)
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return n;
+}
+
+
+/** Convert cmd. line argument to real number */
+static double arg2real(const char * arg) {
+    char * err;
+    double d = strtod(arg, &err);
+    if ('\0' != *err)
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return d;
+}
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    unsigned long long seed = 1;  // PRNG seed
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--seed" == opt && opts + 1 < argc)
+            seed = arg2size(argv[++opts]);
+        else
+            opts_ok = false;
+    }
+
+    // Shift positional arguments
+    argc -= opts - 1;
+    argv += opts - 1;
+
+    if (!opts_ok || 5 != argc) {
+        std::cerr
+            << "Usage: " << prog << " [--seed S] "
+               "{dna|text|bytes} <length> <edit_rate> <pairs>"
+            << std::endl
+            << std::endl
+            << "Generates reproducible corpus of string pairs; the first"
+            << std::endl
+            << "string of each pair is random, the second one is its copy"
+            << std::endl
+            << "with random edits (each position edited with probability"
+            << std::endl
+            << "edit_rate).  The pairs are printed line by line,"
+            << std::endl
+            << "as expected by the levenshtein and hirschberg CLIs."
+            << std::endl
+            << "The corpus is determined by the parameters and the seed"
+            << std::endl
+            << "(default: " << seed << ")."
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    benchmark::string::corpus corpus(argv[1], seed);
+
+    const size_t length    = arg2size(argv[2]);
+    const double edit_rate = arg2real(argv[3]);
+    const size_t pairs     = arg2size(argv[4]);
+
+    std::string s1, s2;
+    for (size_t i = 0; i < pairs; ++i) {
+        corpus.pair(length, edit_rate, s1, s2);
+        std::cout << s1 << '\n' << s2 << '\n';
+    }
+
+    std::cout.flush();
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,200 @@
+#ifndef benchmark__string__corpus_hxx
+#define benchmark__string__corpus_hxx
+
+/**
+ *  \file
+ *  \brief  Reproducible string pair corpus generator
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace benchmark {
+namespace string {
+
+/**
+ *  \brief  String pair corpus generator
+ *
+ *  Generates random strings over an alphabet and their copies mutated
+ *  by random edits.  The generator uses its own PRNG (SplitMix64)
+ *  and its own value mapping, so the corpus is determined by the seed
+ *  only (it doesn't depend on the standard library implementation).
+ */
+class corpus {
+    private:
+
+    const std::string m_alphabet;  /**< Alphabet */
+    uint64_t          m_state;     /**< PRNG state */
+
+    /** Next pseudo-random number (SplitMix64) */
+    uint64_t next() {
+        uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /** Pseudo-random number from [0, n) */
+    size_t uniform(size_t n) { return next() % n; }
+
+    /** Pseudo-random real number from [0, 1) */
+    double real() { return (next() >> 11) * (1.0 / (1ULL << 53)); }
+
+    /** Pseudo-random alphabet character */
+    char character() { return m_alphabet[uniform(m_alphabet.size())]; }
+
+    public:
+
+    /**
+     *  \brief  Alphabet by name
+     *
+     *  Supported alphabets:
+     *  \c dna   (ACGT),
+     *  \c text  (printable ASCII),
+     *  \c bytes (all bytes but the new line, so that corpora may be stored
+     *            line by line)
+     *
+     *  \param  name  Alphabet name
+     *
+     *  \return Alphabet characters
+     */
+    static std::string alphabet(const std::string & name) {
+        if ("dna" == name) return "ACGT";
+
+        std::string alphabet;
+        if ("text" == name) {
+            for (int c = 0x20; c < 0x7f; ++c) alphabet.push_back(c);
+        }
+        else if ("bytes" == name) {
+            for (int c = 0; c < 0x100; ++c)
+                if ('\n' != c) alphabet.push_back(c);
+        }
+        else
+            throw std::runtime_error("Unsupported alphabet: " + name);
+
+        return alphabet;
+    }
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  alphabet_name  Alphabet name (see \c alphabet)
+     *  \param  seed           PRNG seed
+     */
+    corpus(const std::string & alphabet_name, uint64_t seed):
+        m_alphabet(alphabet(alphabet_name)),
+        m_state(seed)
+    {}
+
+    /**
+     *  \brief  Random string
+     *
+     *  \param  size  String length
+     *
+     *  \return Random string
+     */
+    std::string random(size_t size) {
+        std::string s(size, '\0');
+        for (size_t i = 0; i < size; ++i) s[i] = character();
+
+        return s;
+    }
+
+    /**
+     *  \brief  Mutated string
+     *
+     *  Each position of \c s is edited with probability \c edit_rate;
+     *  substitution, insertion and deletion are equally likely.
+     *
+     *  \param  s          String
+     *  \param  edit_rate  Edit rate
+     *
+     *  \return Mutated copy of \c s
+     */
+    std::string mutate(const std::string & s, double edit_rate) {
+        std::string m;
+        m.reserve(s.size() + s.size() / 4 + 1);
+
+        for (size_t i = 0; i < s.size(); ++i) {
+            if (!(real() < edit_rate)) {
+                m.push_back(s[i]);
+                continue;
+            }
+
+            switch (uniform(3)) {
+                case 0:  // substitution
+                    m.push_back(character());
+                    break;
+
+                case 1:  // insertion
+                    m.push_back(character());
+                    m.push_back(s[i]);
+                    break;
+
+                default:  // deletion
+                    break;
+            }
+        }
+
+        return m;
+    }
+
+    /**
+     *  \brief  Random string pair
+     *
+     *  \param  size       Length of the first string
+     *  \param  edit_rate  Edit rate of the second string
+     *  \param  s1         First string
+     *  \param  s2         Second string (mutated \c s1)
+     */
+    void pair(size_t size, double edit_rate, std::string & s1, std::string & s2)
+    {
+        s1 = random(size);
+        s2 = mutate(s1, edit_rate);
+    }
+
+};  // end of class corpus
+
+}}  // end of namespaces string benchmark
+
+#endif  // end of #ifndef benchmark__string__corpus_hxx
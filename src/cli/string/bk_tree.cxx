@@ -0,0 +1,171 @@
+/**
+ *  \file
+ *  \brief  BK-tree fuzzy search: CLI
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/string/bk_tree.hxx"
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+
+
+/** Convert cmd. line argument to non-negative integer */
+static size_t arg2size(const char * arg) {
+    char * err;
+    unsigned long long n = strtoull(arg, &err, 10);
+    if ('\0' != *err || '-' == *arg)
+        throw std::runtime_error(
+            std::string("Invalid argument: ") + arg);
+
+    return n;
+}
+
+
+/**
+ *  \brief  Load BK-tree
+ *
+ *  The file is either a serialised tree or a dictionary (one word per line).
+ *
+ *  \param  file  File name
+ *  \param  tree  Tree
+ */
+static void load(const char * file, algorithm::string::bk_tree & tree) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) throw std::runtime_error(std::string("Can't open ") + file);
+
+    if (algorithm::string::bk_tree::is_saved(in)) {
+        tree.load(in);
+        return;
+    }
+
+    for (std::string word; std::getline(in, word); )
+        tree.insert(word);
+}
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    const std::string cmd(argc > 1 ? argv[1] : "");
+
+    if (!(4 == argc && ("dist" == cmd || "nearest" == cmd || "save" == cmd))) {
+        std::cerr
+            << "Usage: " << argv[0] << " {dist <k>|nearest <n>} <dictionary>"
+            << std::endl
+            << "       " << argv[0] << " save <dictionary> <index>"
+            << std::endl
+            << std::endl
+            << "Fuzzy search in a dictionary using BK-tree index."
+            << std::endl
+            << std::endl
+            << "The dictionary is either a text file (one word per line)"
+            << std::endl
+            << "or the index saved by the save command."
+            << std::endl
+            << "The process reads queries from its std. input (one per line)"
+            << std::endl
+            << "and prints either all the dictionary words within k edits"
+            << std::endl
+            << "or the n nearest ones (word and its distance per line,"
+            << std::endl
+            << "sorted by the distance), followed by an empty line."
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    algorithm::string::bk_tree tree;
+
+    // Save index
+    if ("save" == cmd) {
+        load(argv[2], tree);
+
+        std::ofstream out(argv[3], std::ios::binary);
+        if (!out)
+            throw std::runtime_error(std::string("Can't open ") + argv[3]);
+
+        tree.save(out);
+        return 0;
+    }
+
+    // Answer queries
+    const size_t param = arg2size(argv[2]);
+    load(argv[3], tree);
+
+    for (std::string query; std::getline(std::cin, query); ) {
+        const auto matches = "dist" == cmd
+            ? tree.find(query, param)
+            : tree.nearest(query, param);
+
+        for (const auto & match: matches)
+            std::cout
+                << tree.word(match.first) << '\t' << match.second << '\n';
+
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -43,8 +43,17 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <memory>
 #include <cstdlib>
+#include <cstring>
 #include <climits>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 
 /** Convert cmd. line argument to integer */
@@ -67,17 +76,260 @@ static int arg2int(const char * arg) {
 }
 
 
+/**
+ *  \brief  Memory-mapped sequence file
+ *
+ *  The file is mapped read-only and the sequence is used in place.
+ *  With FASTA format, header (\c '>' and \c ';') lines and line breaks
+ *  are skipped.  If the (1st record's) sequence spans several lines,
+ *  it isn't contiguous in the file, so it is copied (without the line
+ *  breaks) to memory; i.e. line-wrapped FASTA costs a full copy of
+ *  the sequence.  Otherwise, the whole file (without the final line
+ *  break) is the sequence.
+ */
+class sequence_file {
+    private:
+
+    char       * m_map;       /**< Mapping                          */
+    size_t       m_map_size;  /**< Mapping size                     */
+    const char * m_data;      /**< Sequence                         */
+    size_t       m_size;      /**< Sequence length                  */
+    std::string  m_copy;      /**< Sequence copy (multi-line FASTA) */
+
+    /** Throw system error */
+    static void fail(const char * what, const char * file) {
+        throw std::runtime_error(
+            std::string(what) + " " + file + ": " + ::strerror(errno));
+    }
+
+    /** Find FASTA sequence of the 1st record */
+    void parse_fasta() {
+        const char * in     = m_map;
+        const char * end    = m_map + m_map_size;
+        bool         header = false;  // record header seen
+        size_t       lines  = 0;      // sequence lines
+
+        m_data = m_map;
+        m_size = 0;
+
+        while (in < end) {
+            const char * eol = (const char *)::memchr(in, '\n', end - in);
+            if (NULL == eol) eol = end;
+
+            // Next record header ends the sequence
+            if ('>' == *in) {
+                if (header) break;
+                header = true;
+            }
+
+            // Sequence line (header and comment lines are skipped)
+            else if (';' != *in) {
+                const char * line_end = eol;
+                if (line_end > in && '\r' == line_end[-1]) --line_end;
+
+                const size_t len = line_end - in;
+
+                // Empty lines don't count (so they don't force a copy)
+                if (0 == len) {
+                    in = eol + 1;
+                    continue;
+                }
+
+                // The 1st line is used in place, the others are copied
+                if (0 == lines)
+                    m_data = in;
+                else {
+                    if (1 == lines) {
+                        m_copy.reserve(end - m_data);
+                        m_copy.assign(m_data, m_size);
+                    }
+
+                    m_copy.append(in, len);
+                }
+
+                m_size += len;
+                ++lines;
+            }
+
+            in = eol + 1;
+        }
+
+        if (lines > 1) m_data = m_copy.data();
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor (maps the file)
+     *
+     *  \param  file   File name
+     *  \param  fasta  FASTA format
+     */
+    sequence_file(const char * file, bool fasta):
+        m_map(NULL),
+        m_map_size(0),
+        m_data(NULL),
+        m_size(0)
+    {
+        const int fd = ::open(file, O_RDONLY);
+        if (-1 == fd) fail("Can't open", file);
+
+        struct stat st;
+        if (-1 == ::fstat(fd, &st)) {
+            ::close(fd);
+            fail("Can't stat", file);
+        }
+
+        m_map_size = st.st_size;
+
+        if (m_map_size > 0) {
+            void * map = ::mmap(NULL, m_map_size, PROT_READ, MAP_PRIVATE,
+                fd, 0);
+
+            if (MAP_FAILED == map) {
+                ::close(fd);
+                fail("Can't map", file);
+            }
+
+            m_map = (char *)map;
+        }
+
+        ::close(fd);
+
+        if (fasta) {
+            parse_fasta();
+            return;
+        }
+
+        m_data = m_map;
+        m_size = m_map_size;
+        if (m_size > 0 && '\n' == m_data[m_size - 1]) --m_size;
+        if (m_size > 0 && '\r' == m_data[m_size - 1]) --m_size;
+    }
+
+    /** Sequence */
+    const char * data() const { return m_data; }
+
+    /** Sequence length */
+    size_t size() const { return m_size; }
+
+    /** Destructor (unmaps the file) */
+    ~sequence_file() {
+        if (NULL != m_map) ::munmap(m_map, m_map_size);
+    }
+
+};  // end of class sequence_file
+
+
+/**
+ *  \brief  Align strings, streaming the alignment to output
+ *
+ *  \param  hirschberg  Hirschberg's algorithm
+ *  \param  s1          A string
+ *  \param  s1_size     Length of \c s1
+ *  \param  s2          Another string
+ *  \param  s2_size     Length of \c s2
+ *  \param  out         Alignment output (flushed at the end)
+ *  \param  ws          Workspace
+ *  \param  pool        Thread pool (optional)
+ */
+template <class Hirschberg, class Output>
+static void align_stream(
+    const Hirschberg                        & hirschberg,
+    const char * s1, size_t s1_size,
+    const char * s2, size_t s2_size,
+    Output                                  & out,
+    algorithm::string::hirschberg_workspace & ws,
+    algorithm::parallel::thread_pool        * pool)
+{
+    if (NULL != pool)
+        hirschberg.align(s1, s1_size, s2, s2_size, out, ws, *pool);
+    else
+        hirschberg.align(s1, s1_size, s2, s2_size, out, ws);
+
+    out.flush();
+}
+
+
+/** Hirschberg's algorithm with constant costs */
+typedef algorithm::string::hirschberg<
+    algorithm::string::const_cost,
+    algorithm::string::const_cost,
+    algorithm::string::match_cost> hirschberg_t;
+
+
 /** CLI wrapper */
 static int main_impl(int argc, char * const argv[]) {
     int del_cost = -2;  // Cost of deletion
     int ins_cost = -2;  // Cost of insertion
     int sub_cost = -1;  // Cost of substitution
     int eql_cost =  2;  // Cost of character match
+    int threads  =  1;  // Number of threads (0 means number of CPUs)
+    int par_cut  = -1;  // Parallel computation cutoff (-1 means default)
+    int band     =  0;  // Band width (0 means unbanded)
+    int leaf     = -1;  // Full score matrix cutoff (-1 means default)
+    bool cigar   = false;  // Print edit script instead of alignment
+    bool stats   = false;  // Print computation statistics
+    bool fasta   = false;  // Input files are in FASTA format
+    int  width   = 60;     // Alignment block width (files mode)
+
+    const char * file1 = NULL;  // 1st sequence file
+    const char * file2 = NULL;  // 2nd sequence file
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--threads" == opt && opts + 1 < argc) {
+            threads = arg2int(argv[++opts]);
+            if (threads < 0) opts_ok = false;
+        }
+        else if ("--parallel-cutoff" == opt && opts + 1 < argc) {
+            par_cut = arg2int(argv[++opts]);
+            if (par_cut < 0) opts_ok = false;
+        }
+        else if ("--band" == opt && opts + 1 < argc) {
+            band = arg2int(argv[++opts]);
+            if (band < 0) opts_ok = false;
+        }
+        else if ("--leaf" == opt && opts + 1 < argc) {
+            leaf = arg2int(argv[++opts]);
+            if (leaf < 0) opts_ok = false;
+        }
+        else if ("--cigar" == opt)
+            cigar = true;
+        else if ("--stats" == opt)
+            stats = true;
+        else if ("--files" == opt && opts + 2 < argc) {
+            file1 = argv[++opts];
+            file2 = argv[++opts];
+        }
+        else if ("--fasta" == opt)
+            fasta = true;
+        else if ("--width" == opt && opts + 1 < argc) {
+            width = arg2int(argv[++opts]);
+            if (width < 1) opts_ok = false;
+        }
+        else
+            opts_ok = false;
+    }
+
+    // Shift positional arguments
+    argc -= opts - 1;
+    argv += opts - 1;
 
-    if (!(argc < 6 || 7 == argc)) {
+    if (!opts_ok || !(argc < 6 || (7 == argc && NULL == file1))) {
         std::cerr
-            << "Usage: " << argv[0] << " [del] [ins] [sub] [eql] "
-               "[string1 string2]"
+            << "Usage: " << prog << " [--threads N] [--parallel-cutoff P] "
+               "[--band K] [--leaf C] [--cigar] [--stats] "
+               "[del] [ins] [sub] [eql] [string1 string2]"
+            << std::endl
+            << "       " << prog << " --files FILE_1 FILE_2 [--fasta] "
+               "[--width W] [options] [del] [ins] [sub] [eql]"
             << std::endl
             << std::endl
             << "Hirschberg's strings alignment computation."
@@ -101,6 +353,64 @@ static int main_impl(int argc, char * const argv[]) {
             << std::endl
             << "(one per each line) and prints the result per each 2 lines."
             << std::endl
+            << std::endl
+            << "With --files, the strings are the (memory-mapped) files'"
+            << std::endl
+            << "contents and the alignment is written as it's computed,"
+            << std::endl
+            << "in blocks of W columns (1st string, 2nd string, empty line)."
+            << std::endl
+            << "With --threads other than 1, the right halves of the alignment"
+            << std::endl
+            << "are buffered in memory (up to about half of the alignment)"
+            << std::endl
+            << "so the output is only streamed in part."
+            << std::endl
+            << std::endl
+            << "Options:"
+            << std::endl
+            << "  --threads N  compute long alignments by N threads "
+               "(0 means number of CPUs, default: " << threads << ")"
+            << std::endl
+            << "  --parallel-cutoff P"
+            << std::endl
+            << "               compute sub-problems of less than P score"
+               " matrix cells"
+            << std::endl
+            << "               serially (default: "
+            << hirschberg_t::parallel_cutoff_dflt << ")"
+            << std::endl
+            << "  --band K     compute only score matrix band around"
+               " the diagonal,"
+            << std::endl
+            << "               K is the expected max. number of edits"
+               " (0 means unbanded)"
+            << std::endl
+            << "  --leaf C     align sub-problems of up to C score matrix"
+               " cells"
+            << std::endl
+            << "               using full matrix (default: fits CPU cache,"
+               " 0 means never)"
+            << std::endl
+            << "  --cigar      print the alignment as edit script (CIGAR"
+               " string of"
+            << std::endl
+            << "               =, X, D and I runs) instead of the aligned"
+               " strings"
+            << std::endl
+            << "  --stats      print computation statistics to std. error"
+               " at the end"
+            << std::endl
+            << "  --fasta      the files are in FASTA format (header lines"
+               " and line"
+            << std::endl
+            << "               breaks are skipped; the 1st record is used)."
+            << std::endl
+            << "               Sequences spanning several lines are copied"
+               " to memory"
+            << std::endl
+            << "  --width W    alignment block width (default: " << width << ")"
+            << std::endl
             << std::endl;
 
         return 1;
@@ -112,38 +422,91 @@ static int main_impl(int argc, char * const argv[]) {
     if (argc > 3) sub_cost = arg2int(argv[3]);
     if (argc > 4) eql_cost = arg2int(argv[4]);
 
-    // Instantiate Hirschberg's algorithm
-    auto del = [del_cost](char c) -> int { return del_cost; };
-    auto ins = [ins_cost](char c) -> int { return ins_cost; };
-    auto sub = [sub_cost, eql_cost](char a, char b) -> int {
-        return a == b ? eql_cost : sub_cost;
-    };
+    // Instantiate Hirschberg's algorithm (constant costs)
+    typedef algorithm::string::const_cost const_cost;
+    typedef algorithm::string::match_cost match_cost;
 
-    algorithm::string::hirschberg<
-        decltype(del), decltype(ins), decltype(sub)>
-            hirschberg(del, ins, sub);
+    hirschberg_t hirschberg(
+        const_cost(del_cost),
+        const_cost(ins_cost),
+        match_cost(eql_cost, sub_cost));
 
-    // Strings passed as cmd. line arguments
-    if (7 == argc) {
-        auto align = hirschberg(argv[5], argv[6]);
+    hirschberg.band(band);
+    if (par_cut >= 0) hirschberg.parallel_cutoff(par_cut);
+    if (leaf >= 0) hirschberg.leaf_cells(leaf);
+
+    // Thread pool (parallel mode)
+    std::unique_ptr<algorithm::parallel::thread_pool> pool;
+    if (1 != threads) pool.reset(new algorithm::parallel::thread_pool(threads));
+
+    // The workspace is reused
+    algorithm::string::hirschberg_workspace ws;
+    auto align = [&](const std::string & s1, const std::string & s2) {
+        // Edit script is streamed directly to output
+        if (cigar) {
+            algorithm::string::edit_script_stream out(std::cout);
+            align_stream(hirschberg,
+                s1.data(), s1.size(), s2.data(), s2.size(),
+                out, ws, pool.get());
+            std::cout << std::endl;
+
+            return;
+        }
+
+        auto alignment = pool
+            ? hirschberg(s1, s2, ws, *pool)
+            : hirschberg(s1, s2, ws);
 
         std::cout
-            << std::get<0>(align) << std::endl
-            << std::get<1>(align) << std::endl;
+            << std::get<0>(alignment) << std::endl
+            << std::get<1>(alignment) << std::endl;
+    };
+
+    // Memory-mapped files (the alignment is streamed)
+    if (NULL != file1) {
+        const sequence_file seq1(file1, fasta);
+        const sequence_file seq2(file2, fasta);
 
-        return 0;
+        if (cigar) {
+            algorithm::string::edit_script_stream out(std::cout);
+            align_stream(hirschberg,
+                seq1.data(), seq1.size(), seq2.data(), seq2.size(),
+                out, ws, pool.get());
+            std::cout << std::endl;
+        }
+        else {
+            algorithm::string::padded_alignment_stream out(std::cout, width);
+            align_stream(hirschberg,
+                seq1.data(), seq1.size(), seq2.data(), seq2.size(),
+                out, ws, pool.get());
+            std::cout.flush();
+        }
     }
 
+    // Strings passed as cmd. line arguments
+    else if (7 == argc)
+        align(argv[5], argv[6]);
+
     // Strings from input
-    for (std::string arg1, arg2; ;) {
-        if (std::getline(std::cin, arg1).eof()) break;
-        if (std::getline(std::cin, arg2).eof()) break;
+    else {
+        for (std::string arg1, arg2; ;) {
+            if (std::getline(std::cin, arg1).eof()) break;
+            if (std::getline(std::cin, arg2).eof()) break;
 
-        auto align = hirschberg(arg1, arg2);
+            align(arg1, arg2);
+        }
+    }
 
-        std::cout
-            << std::get<0>(align) << std::endl
-            << std::get<1>(align) << std::endl;
+    pool.reset();  // finish workers (so that their statistics are final)
+
+    // Computation statistics
+    if (stats) {
+        if (algorithm::string::stats::enabled)
+            algorithm::string::stats::total().print(std::cerr);
+        else
+            std::cerr
+                << "Statistics unavailable (built without ALGORITHM_STATS)"
+                << std::endl;
     }
 
     return 0;
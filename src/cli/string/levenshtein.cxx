@@ -39,80 +39,696 @@
  */
 
 
+
 #include "algorithm/string/levenshtein.hxx"
+#include "algorithm/parallel/thread_pool.hxx"
 
 #include <iostream>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <climits>
+#include <cerrno>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+/** Convert cmd. line argument to integer */
+static int arg2int(const char * arg) {
+    char * err;
+    long i = strtol(arg, &err, 10);
+    if ('\0' != *err || !(INT_MIN <= i && i <= INT_MAX))
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return i;
+}
 
 
-/** Computation implementation */
-class computer {
-    public:
+/** Convert cmd. line argument to real number */
+static double arg2real(const char * arg) {
+    char * err;
+    double d = strtod(arg, &err);
+    if ('\0' != *err)
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
 
-    virtual void operator () (
-        std::ostream      & out,
-        const std::string & s1,
-        const std::string & s2)
-    const = 0;
-
-};  // end of class computer
+    return d;
+}
 
 
 /** Levenshtein distance computer */
-class levenshtein_dist: public computer {
+class levenshtein_dist {
+    private:
+
+    const bool   m_thresholded;  /**< Threshold is set */
+    const size_t m_max_k;        /**< Distance threshold */
+    const bool   m_utf8;         /**< UTF-8 strings */
+
     public:
 
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  threshold  Distance threshold (negative means none)
+     *  \param  utf8       Compute on UTF-8 code points
+     */
+    levenshtein_dist(double threshold, bool utf8):
+        m_thresholded(threshold >= 0),
+        m_max_k(threshold >= 0 ? (size_t)threshold : 0),
+        m_utf8(utf8)
+    {}
+
+    /**
+     *  \brief  Compute the distance
+     *
+     *  \param  out      Output (the result is appended)
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     */
     void operator () (
-        std::ostream      & out,
-        const std::string & s1,
-        const std::string & s2)
+        std::string & out,
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size)
     const {
-        out << algorithm::string::levenshtein_dist(s1, s2);
+        size_t dist;
+        if (m_utf8) {
+            dist = algorithm::string::levenshtein_dist_utf8(
+                s1, s1_size, s2, s2_size);
+
+            if (m_thresholded && dist > m_max_k) dist = m_max_k + 1;
+        }
+        else {
+            dist = m_thresholded
+                ? algorithm::string::levenshtein_dist(
+                    s1, s1_size, s2, s2_size, m_max_k)
+                : algorithm::string::levenshtein_dist(
+                    s1, s1_size, s2, s2_size);
+        }
+
+        char result[24];
+        out.append(result, ::snprintf(result, sizeof(result), "%zu", dist));
     }
 
-};  // end of class levenshtein_dist_computer
+};  // end of class levenshtein_dist
 
 
 /** Levenshtein similarity computer */
-class levenshtein_simi: public computer {
+class levenshtein_simi {
+    private:
+
+    const bool   m_thresholded;  /**< Threshold is set */
+    const double m_min_simi;     /**< Similarity threshold */
+    const bool   m_utf8;         /**< UTF-8 strings */
+
     public:
 
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  threshold  Similarity threshold (negative means none)
+     *  \param  utf8       Compute on UTF-8 code points
+     */
+    levenshtein_simi(double threshold, bool utf8):
+        m_thresholded(threshold >= 0),
+        m_min_simi(threshold),
+        m_utf8(utf8)
+    {}
+
+    /**
+     *  \brief  Compute the similarity
+     *
+     *  The result is formatted the same way as by \c std::ostream.
+     *
+     *  \param  out      Output (the result is appended)
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     */
     void operator () (
-        std::ostream      & out,
-        const std::string & s1,
-        const std::string & s2)
+        std::string & out,
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size)
     const {
-        out << algorithm::string::levenshtein_simi(s1, s2);
+        double simi;
+        if (m_utf8) {
+            simi = algorithm::string::levenshtein_simi_utf8(
+                s1, s1_size, s2, s2_size);
+
+            if (m_thresholded && simi < m_min_simi) simi = 0.0;
+        }
+        else {
+            simi = m_thresholded
+                ? algorithm::string::levenshtein_simi(
+                    s1, s1_size, s2, s2_size, m_min_simi)
+                : algorithm::string::levenshtein_simi(
+                    s1, s1_size, s2, s2_size);
+        }
+
+        char result[32];
+        out.append(result, ::snprintf(result, sizeof(result), "%g", simi));
     }
 
-};  // end of class levenshtein_dist_computer
+};  // end of class levenshtein_simi
+
+
+/** Levenshtein edit script computer */
+class levenshtein_script {
+    public:
+
+    /**
+     *  \brief  Compute the edit script (CIGAR)
+     *
+     *  \param  out      Output (the result is appended)
+     *  \param  s1       A string
+     *  \param  s1_size  Length of \c s1
+     *  \param  s2       Another string
+     *  \param  s2_size  Length of \c s2
+     */
+    void operator () (
+        std::string & out,
+        const char * s1, size_t s1_size,
+        const char * s2, size_t s2_size)
+    const {
+        out += algorithm::string::levenshtein_script(
+            s1, s1_size, s2, s2_size).str();
+    }
+
+};  // end of class levenshtein_script
 
 
 /**
- *  \brief  Computer resolver
+ *  \brief  Batch computation
  *
- *  Throws an exception if computer identification is faulty
+ *  Input lines are used in place (the pairs are only referenced).
+ *  Pairs are computed by chunks; if a thread pool is provided,
+ *  the chunks are computed in parallel.  Each chunk formats its results
+ *  into its own buffer; the buffers are written in input order.
+ */
+template <class Computer>
+class batch {
+    private:
+
+    /** String reference */
+    struct str_t {
+        const char * data;
+        size_t       size;
+    };  // end of struct str_t
+
+    static constexpr size_t chunk_pairs  = 4096;        /**< Pairs per task */
+    static constexpr size_t window_pairs = 1024 * 1024; /**< Pairs per round */
+
+    const Computer &                  m_comp;    /**< Computer */
+    algorithm::parallel::thread_pool * m_pool;   /**< Thread pool */
+    std::vector<str_t>                m_lines;   /**< Lines of a round */
+    std::vector<std::string>          m_output;  /**< Chunk outputs */
+
+    /** Compute a chunk of pairs */
+    void compute(size_t chunk) {
+        const size_t begin = chunk * chunk_pairs * 2;
+        const size_t end   = std::min(begin + chunk_pairs * 2, m_lines.size());
+
+        std::string & out = m_output[chunk];
+        out.clear();
+
+        for (size_t i = begin; i < end; i += 2) {
+            const str_t & s1 = m_lines[i];
+            const str_t & s2 = m_lines[i + 1];
+
+            m_comp(out, s1.data, s1.size, s2.data, s2.size);
+            out += '\n';
+        }
+    }
+
+    /** Compute the round of pairs and write the results */
+    void flush() {
+        const size_t chunks =
+            (m_lines.size() / 2 + chunk_pairs - 1) / chunk_pairs;
+
+        m_output.resize(chunks);
+
+        if (NULL != m_pool) {
+            algorithm::parallel::task_group group(*m_pool);
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+                group.run([this, chunk]() { compute(chunk); });
+
+            group.wait();
+        }
+        else
+            for (size_t chunk = 0; chunk < chunks; ++chunk)
+                compute(chunk);
+
+        for (size_t chunk = 0; chunk < chunks; ++chunk)
+            std::cout.write(m_output[chunk].data(), m_output[chunk].size());
+
+        m_lines.clear();
+    }
+
+    public:
+
+    /**
+     *  \brief  Constructor
+     *
+     *  \param  comp  Computer
+     *  \param  pool  Thread pool (optional)
+     */
+    batch(const Computer & comp, algorithm::parallel::thread_pool * pool):
+        m_comp(comp), m_pool(pool)
+    {}
+
+    /**
+     *  \brief  Process input data
+     *
+     *  Only complete pairs of lines are processed; unless \c eof is set,
+     *  the rest is left for the next call (with more data appended).
+     *  At the end of input, the last line needn't be terminated.
+     *
+     *  \param  data  Input data
+     *  \param  size  Input data size
+     *  \param  eof   End of input
+     *
+     *  \return Number of input bytes processed
+     */
+    size_t operator () (const char * data, size_t size, bool eof) {
+        const char * const end = data + size;
+
+        const char * pos  = data;  // processed so far
+        const char * line = data;  // current line
+        while (line < end) {
+            const char * nl = (const char *)::memchr(line, '\n', end - line);
+            if (NULL == nl) {
+                if (!eof) break;
+                nl = end;
+            }
+
+            m_lines.push_back(str_t{line, (size_t)(nl - line)});
+            line = nl + 1;
+
+            // Complete pair
+            if (0 == m_lines.size() % 2) {
+                pos = line < end ? line : end;
+                if (m_lines.size() == window_pairs * 2) flush();
+            }
+        }
+
+        // Incomplete pair is postponed (or dropped at end of input)
+        if (m_lines.size() % 2) m_lines.pop_back();
+
+        flush();
+
+        return pos - data;
+    }
+
+};  // end of class batch
+
+template <class Computer>
+constexpr size_t batch<Computer>::chunk_pairs;
+
+template <class Computer>
+constexpr size_t batch<Computer>::window_pairs;
+
+
+/**
+ *  \brief  Batch computation on a file
  *
- *  \param  cid  Computer identification ("dist" | "simi")
+ *  The file is memory-mapped; if it can't be (e.g. it's a pipe),
+ *  it's read by large blocks.
  *
- *  \return Computer
+ *  \param  proc  Batch processor
+ *  \param  fd    Input file descriptor
  */
-static const computer & resolve_computer(const std::string & cid) {
-    static const levenshtein_dist dist;
-    static const levenshtein_simi simi;
+template <class Computer>
+static void compute_batch(batch<Computer> & proc, int fd) {
+    struct stat st;
+    if (0 == ::fstat(fd, &st) && S_ISREG(st.st_mode) && 0 < st.st_size) {
+        void * data = ::mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED != data) {
+            ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+            proc((const char *)data, st.st_size, true);
+
+            ::munmap(data, st.st_size);
+            return;
+        }
+    }
+
+    // Read by blocks, the unprocessed rest is kept for the next block
+    static constexpr size_t block_size = 16 * 1024 * 1024;
 
-    if ("dist" == cid) return dist;
-    if ("simi" == cid) return simi;
+    std::vector<char> buffer(block_size);
+    size_t size = 0;
+    for (bool eof = false; !eof; ) {
+        if (buffer.size() - size < block_size / 2)
+            buffer.resize(buffer.size() * 2);
 
-    throw std::runtime_error("Unsupported computation requested");
+        const ssize_t rcnt = ::read(fd, &buffer[size], buffer.size() - size);
+        if (rcnt < 0) {
+            if (EINTR == errno) continue;
+            throw std::runtime_error(
+                std::string("Input read failed: ") + ::strerror(errno));
+        }
+
+        size += rcnt;
+        eof   = 0 == rcnt;
+
+        const size_t done = proc(buffer.data(), size, eof);
+        ::memmove(buffer.data(), buffer.data() + done, size - done);
+        size -= done;
+    }
+}
+
+
+/**
+ *  \brief  Computation
+ *
+ *  \param  comp       Computer
+ *  \param  argc       Positional arguments count
+ *  \param  argv       Positional arguments
+ *  \param  batch_mode Use batch mode for input
+ *  \param  input      Input file (or \c NULL for std. input)
+ *  \param  threads    Number of threads (batch mode)
+ *
+ *  \return Exit code
+ */
+template <class Computer>
+static int compute(
+    const Computer &   comp,
+    int                argc,
+    char * const       argv[],
+    bool               batch_mode,
+    const char *       input,
+    int                threads)
+{
+    std::string result;
+
+    // Computation arguments passed as cmd. line arguments
+    if (4 == argc) {
+        comp(result,
+            argv[2], ::strlen(argv[2]), argv[3], ::strlen(argv[3]));
+
+        std::cout << result << std::endl;
+
+        return 0;
+    }
+
+    // Computation arguments from input (line by line)
+    if (!batch_mode) {
+        for (std::string arg1, arg2; ;) {
+            if (std::getline(std::cin, arg1).eof()) break;
+            if (std::getline(std::cin, arg2).eof()) break;
+
+            result.clear();
+            comp(result, arg1.data(), arg1.size(), arg2.data(), arg2.size());
+
+            std::cout << result << std::endl;
+        }
+
+        return 0;
+    }
+
+    // Batch mode
+    std::unique_ptr<algorithm::parallel::thread_pool> pool;
+    if (1 != threads) pool.reset(new algorithm::parallel::thread_pool(threads));
+
+    int fd = STDIN_FILENO;
+    if (NULL != input) {
+        fd = ::open(input, O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error(
+                std::string("Failed to open ") + input + ": " +
+                ::strerror(errno));
+    }
+
+    batch<Computer> proc(comp, pool.get());
+
+    try {
+        compute_batch(proc, fd);
+    }
+    catch (...) {
+        if (STDIN_FILENO != fd) ::close(fd);
+        throw;
+    }
+
+    if (STDIN_FILENO != fd) ::close(fd);
+
+    std::cout.flush();
+
+    return 0;
+}
+
+
+/** Levenshtein distances of string sets */
+struct levenshtein_dist_set {
+    typedef size_t result_t;  /**< Result type */
+
+    /** Query x candidates */
+    static void compute(
+        const std::string & query, const std::vector<std::string> & cands,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_dist(query, cands, res, pool);
+    }
+
+    /** Matrix */
+    static void compute(
+        const std::vector<std::string> & s1,
+        const std::vector<std::string> & s2,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_dist(s1, s2, res, pool);
+    }
+
+    /** All pairs (upper triangle) */
+    static void compute(
+        const std::vector<std::string> & s,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_dist(s, res, pool);
+    }
+
+    /** Append result to output */
+    static void format(std::string & out, result_t dist) {
+        char result[24];
+        out.append(result, ::snprintf(result, sizeof(result), "%zu", dist));
+    }
+
+};  // end of struct levenshtein_dist_set
+
+
+/** Levenshtein similarities of string sets */
+struct levenshtein_simi_set {
+    typedef double result_t;  /**< Result type */
+
+    /** Query x candidates */
+    static void compute(
+        const std::string & query, const std::vector<std::string> & cands,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_simi(query, cands, res, pool);
+    }
+
+    /** Matrix */
+    static void compute(
+        const std::vector<std::string> & s1,
+        const std::vector<std::string> & s2,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_simi(s1, s2, res, pool);
+    }
+
+    /** All pairs (upper triangle) */
+    static void compute(
+        const std::vector<std::string> & s,
+        result_t * res, algorithm::parallel::thread_pool * pool)
+    {
+        algorithm::string::levenshtein_simi(s, res, pool);
+    }
+
+    /** Append result to output */
+    static void format(std::string & out, result_t simi) {
+        char result[32];
+        out.append(result, ::snprintf(result, sizeof(result), "%g", simi));
+    }
+
+};  // end of struct levenshtein_simi_set
+
+
+/**
+ *  \brief  Read lines of a file
+ *
+ *  \param  file  File (or \c NULL for std. input)
+ *
+ *  \return Lines
+ */
+static std::vector<std::string> read_lines(const char * file) {
+    std::ifstream fin;
+    if (NULL != file) {
+        fin.open(file);
+        if (!fin)
+            throw std::runtime_error(
+                std::string("Failed to open ") + file);
+    }
+
+    std::istream & in = NULL != file ? fin : std::cin;
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line); )
+        lines.push_back(line);
+
+    return lines;
+}
+
+
+/**
+ *  \brief  String set computation
+ *
+ *  The input lines are either candidates matched against the query,
+ *  or rows of the matrix (against the lines of \c matrix file),
+ *  or all of them are paired with each other (if neither is set).
+ *  Matrix rows are printed per line (tab-separated), all-pairs results
+ *  are printed as the upper triangle (row i has results for j > i).
+ *
+ *  \param  input    Input file (or \c NULL for std. input)
+ *  \param  query    Query (or \c NULL)
+ *  \param  matrix   Matrix columns file (or \c NULL)
+ *  \param  threads  Number of threads
+ *
+ *  \return Exit code
+ */
+template <class Set>
+static int compute_set(
+    const char * input,
+    const char * query,
+    const char * matrix,
+    int          threads)
+{
+    typedef typename Set::result_t result_t;
+
+    std::unique_ptr<algorithm::parallel::thread_pool> pool;
+    if (1 != threads) pool.reset(new algorithm::parallel::thread_pool(threads));
+
+    const std::vector<std::string> s1 = read_lines(input);
+    std::string out;
+
+    if (NULL != query) {
+        std::vector<result_t> res(s1.size());
+        Set::compute(query, s1, res.data(), pool.get());
+
+        for (size_t i = 0; i < res.size(); ++i) {
+            Set::format(out, res[i]);
+            out += '\n';
+        }
+    }
+    else if (NULL != matrix) {
+        const std::vector<std::string> s2 = read_lines(matrix);
+
+        std::vector<result_t> res(s1.size() * s2.size());
+        Set::compute(s1, s2, res.data(), pool.get());
+
+        for (size_t i = 0; i < s1.size(); ++i) {
+            for (size_t j = 0; j < s2.size(); ++j) {
+                if (j) out += '\t';
+                Set::format(out, res[i * s2.size() + j]);
+            }
+            out += '\n';
+        }
+    }
+    else {
+        const size_t n = s1.size();
+
+        std::vector<result_t> res(n ? n * (n - 1) / 2 : 0);
+        Set::compute(s1, res.data(), pool.get());
+
+        size_t k = 0;  // results are stored row by row
+        for (size_t i = 0; i + 1 < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j, ++k) {
+                if (j > i + 1) out += '\t';
+                Set::format(out, res[k]);
+            }
+            out += '\n';
+        }
+    }
+
+    std::cout << out;
+    std::cout.flush();
+
+    return 0;
 }
 
 
 /** CLI wrapper */
 static int main_impl(int argc, char * const argv[]) {
-    if (!(2 == argc || 4 == argc)) {
+    bool         batch_mode = false;  // Batch mode
+    const char * input      = NULL;   // Input file
+    int          threads    = 1;      // Number of threads
+    double       threshold  = -1;     // Threshold (none)
+    bool         utf8       = false;  // UTF-8 strings
+    bool         stats      = false;  // Print computation statistics
+    const char * query      = NULL;   // Query (set computation)
+    const char * matrix     = NULL;   // Matrix columns file
+    bool         all_pairs  = false;  // All pairs of input strings
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--batch" == opt)
+            batch_mode = true;
+        else if ("--utf8" == opt)
+            utf8 = true;
+        else if ("--stats" == opt)
+            stats = true;
+        else if ("--input" == opt && opts + 1 < argc) {
+            input      = argv[++opts];
+            batch_mode = true;
+        }
+        else if ("--query" == opt && opts + 1 < argc)
+            query = argv[++opts];
+        else if ("--matrix" == opt && opts + 1 < argc)
+            matrix = argv[++opts];
+        else if ("--all-pairs" == opt)
+            all_pairs = true;
+        else if ("--threads" == opt && opts + 1 < argc) {
+            threads = arg2int(argv[++opts]);
+            if (threads < 0) opts_ok = false;
+        }
+        else if ("--threshold" == opt && opts + 1 < argc) {
+            threshold = arg2real(argv[++opts]);
+            if (!(threshold >= 0) || !std::isfinite(threshold))
+                opts_ok = false;
+        }
+        else
+            opts_ok = false;
+    }
+
+    // Shift positional arguments
+    argc -= opts - 1;
+    argv += opts - 1;
+
+    // Set computation modes are exclusive, strings come from input
+    const int set_modes = (NULL != query) + (NULL != matrix) + all_pairs;
+    if (set_modes > 1 || (set_modes && 2 != argc)) opts_ok = false;
+
+    if (!opts_ok || !(2 == argc || 4 == argc)) {
         std::cerr
-            << "Usage: " << argv[0] << " {dist|simi} [<string_1> <string_2>]"
+            << "Usage: " << prog << " [options] "
+               "{dist|simi|script} [<string_1> <string_2>]"
             << std::endl
             << std::endl
             << "If the strings are specified via cmd. line arguments,"
@@ -123,31 +739,109 @@ static int main_impl(int argc, char * const argv[]) {
             << std::endl
             << "(one per each line) and prints the dist. per each 2 lines."
             << std::endl
+            << std::endl
+            << "The script computation prints minimal edit script turning"
+            << std::endl
+            << "string_1 into string_2 as CIGAR string (runs of matches (=),"
+            << std::endl
+            << "substitutions (X), deletions (D) and insertions (I))."
+            << std::endl
+            << std::endl
+            << "Options:"
+            << std::endl
+            << "  --batch        compute the input in batch mode "
+               "(results are written"
+            << std::endl
+            << "                 in large blocks, not per each pair)"
+            << std::endl
+            << "  --input FILE   read input from FILE (implies --batch)"
+            << std::endl
+            << "  --query Q      compute the query Q against each input line"
+            << std::endl
+            << "  --matrix FILE  compute each input line against each line "
+               "of FILE"
+            << std::endl
+            << "                 (a row of tab-separated results per input "
+               "line)"
+            << std::endl
+            << "  --all-pairs    compute all pairs of input lines "
+               "(upper triangle rows)"
+            << std::endl
+            << "  --threads N    compute batches by N threads "
+               "(0 means number of CPUs, default: " << threads << ")"
+            << std::endl
+            << "  --threshold T  max. distance (dist) or min. similarity "
+               "(simi) of interest;"
+            << std::endl
+            << "                 greater distance is reported as T + 1, "
+               "lesser similarity as 0"
+            << std::endl
+            << "  --utf8         compute on UTF-8 characters "
+               "(Unicode code points)"
+            << std::endl
+            << "  --stats        print computation statistics to std. error "
+               "at the end"
+            << std::endl
             << std::endl;
 
         return 1;
     }
 
-    const computer & comp = resolve_computer(argv[1]);
+    const std::string cid(argv[1]);
+    int exit_code;
+
+    if (set_modes) {
+        if (threshold >= 0 || utf8)
+            throw std::runtime_error(
+                "Threshold and UTF-8 aren't supported for string sets");
+
+        if ("dist" == cid)
+            exit_code = compute_set<levenshtein_dist_set>(
+                input, query, matrix, threads);
+        else if ("simi" == cid)
+            exit_code = compute_set<levenshtein_simi_set>(
+                input, query, matrix, threads);
+        else
+            throw std::runtime_error(
+                "Unsupported string set computation requested");
+    }
+    else if ("dist" == cid) {
+        // Also keeps the threshold + 1 report representable
+        if (threshold >= 0 && !(threshold < (double)SIZE_MAX))
+            throw std::runtime_error("Distance threshold too great");
 
-    // Computation arguments passed as cmd. line arguments
-    if (4 == argc) {
-        comp(std::cout, argv[2], argv[3]);
-        std::cout << std::endl;
+        if (threshold >= 0 && threshold != std::floor(threshold))
+            throw std::runtime_error("Distance threshold must be integral");
 
-        return 0;
+        exit_code = compute(levenshtein_dist(threshold, utf8),
+            argc, argv, batch_mode, input, threads);
     }
+    else if ("simi" == cid)
+        exit_code = compute(levenshtein_simi(threshold, utf8),
+            argc, argv, batch_mode, input, threads);
 
-    // Computation arguments from input
-    for (std::string arg1, arg2; ;) {
-        if (std::getline(std::cin, arg1).eof()) break;
-        if (std::getline(std::cin, arg2).eof()) break;
+    else if ("script" == cid) {
+        if (threshold >= 0 || utf8)
+            throw std::runtime_error(
+                "Threshold and UTF-8 aren't supported for script");
 
-        comp(std::cout, arg1, arg2);
-        std::cout << std::endl;
+        exit_code = compute(levenshtein_script(),
+            argc, argv, batch_mode, input, threads);
+    }
+    else
+        throw std::runtime_error("Unsupported computation requested");
+
+    // Computation statistics
+    if (stats) {
+        if (algorithm::string::stats::enabled)
+            algorithm::string::stats::total().print(std::cerr);
+        else
+            std::cerr
+                << "Statistics unavailable (built without ALGORITHM_STATS)"
+                << std::endl;
     }
 
-    return 0;
+    return exit_code;
 }
 
 
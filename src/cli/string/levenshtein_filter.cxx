@@ -0,0 +1,119 @@
+/**
+ *  \file
+ *  \brief  Levenshtein automaton stream filter: CLI
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/string/levenshtein_automaton.hxx"
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <cstdlib>
+
+
+/** Convert cmd. line argument to non-negative integer */
+static size_t arg2size(const char * arg) {
+    char * err;
+    unsigned long long n = strtoull(arg, &err, 10);
+    if ('\0' != *err || '-' == *arg)
+        throw std::runtime_error(
+            std::string("Invalid argument: ") + arg);
+
+    return n;
+}
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    if (3 != argc) {
+        std::cerr
+            << "Usage: " << argv[0] << " <query> <k>"
+            << std::endl
+            << std::endl
+            << "Compiles Levenshtein automaton for the query and max. distance k"
+            << std::endl
+            << "and filters words on its std. input (one per line)."
+            << std::endl
+            << "Words within k edits from the query are printed"
+            << std::endl
+            << "with their distance (tab-separated)."
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    const algorithm::string::levenshtein_automaton automaton(
+        argv[1], arg2size(argv[2]));
+
+    for (std::string word; std::getline(std::cin, word); ) {
+        const size_t dist = automaton.dist(word);
+
+        if (dist <= automaton.max_k())
+            std::cout << word << '\t' << dist << '\n';
+    }
+
+    std::cout.flush();
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
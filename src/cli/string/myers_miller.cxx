@@ -0,0 +1,315 @@
+/**
+ *  \file
+ *  \brief  Myers-Miller affine gap string alignment: CLI
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include "algorithm/string/myers_miller.hxx"
+
+#include <iostream>
+#include <stdexcept>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+
+
+/** Convert cmd. line argument to integer */
+static int arg2int(const char * arg) {
+    static char inv_arg[] = "Invalid argument: syntax error at 'X'";
+    static constexpr size_t inv_arg_pos = sizeof(inv_arg) / sizeof(char) - 3;
+
+    char * err;
+    long i = strtol(arg, &err, 10);
+    if ('\0' != *err) {
+        inv_arg[inv_arg_pos] = *err;
+        throw std::runtime_error(inv_arg);
+    }
+
+    if (!(INT_MIN <= i && i <= INT_MAX))
+        throw std::runtime_error(
+            "Invalid argument: (absolute) value too great");
+
+    return i;
+}
+
+
+/** Myers-Miller algorithm with constant costs */
+typedef algorithm::string::myers_miller<
+    algorithm::string::const_cost,
+    algorithm::string::const_cost,
+    algorithm::string::match_cost> myers_miller_t;
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    int open_cost = -3;  // Cost of gap opening
+    int del_cost  = -1;  // Cost of deletion
+    int ins_cost  = -1;  // Cost of insertion
+    int sub_cost  = -1;  // Cost of substitution
+    int eql_cost  =  2;  // Cost of character match
+    int threads   =  1;  // Number of threads (0 means number of CPUs)
+    int par_cut   = -1;  // Parallel computation cutoff (-1 means default)
+    int band      =  0;  // Band width (0 means unbanded)
+    int leaf      = -1;  // Full score matrices cutoff (-1 means default)
+    bool cigar    = false;  // Print edit script instead of alignment
+    bool stats    = false;  // Print computation statistics
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--threads" == opt && opts + 1 < argc) {
+            threads = arg2int(argv[++opts]);
+            if (threads < 0) opts_ok = false;
+        }
+        else if ("--parallel-cutoff" == opt && opts + 1 < argc) {
+            par_cut = arg2int(argv[++opts]);
+            if (par_cut < 0) opts_ok = false;
+        }
+        else if ("--band" == opt && opts + 1 < argc) {
+            band = arg2int(argv[++opts]);
+            if (band < 0) opts_ok = false;
+        }
+        else if ("--leaf" == opt && opts + 1 < argc) {
+            leaf = arg2int(argv[++opts]);
+            if (leaf < 0) opts_ok = false;
+        }
+        else if ("--cigar" == opt)
+            cigar = true;
+        else if ("--stats" == opt)
+            stats = true;
+        else
+            opts_ok = false;
+    }
+
+    // Shift positional arguments
+    argc -= opts - 1;
+    argv += opts - 1;
+
+    if (!opts_ok || !(argc < 7 || 8 == argc)) {
+        std::cerr
+            << "Usage: " << prog << " [--threads N] [--parallel-cutoff P] "
+               "[--band K] [--leaf C] [--cigar] [--stats] "
+               "[open] [del] [ins] [sub] [eql] [string1 string2]"
+            << std::endl
+            << std::endl
+            << "Myers-Miller strings alignment computation (affine gap costs)."
+            << std::endl
+            << std::endl
+            << "The open (" << open_cost << "), del (" << del_cost << "), "
+               "ins (" << ins_cost << "), sub (" << sub_cost << ") "
+               "and eql (" << eql_cost << ")"
+            << std::endl
+            << "parameters are the costs of gap opening, deletion, insertion,"
+            << std::endl
+            << "substitution and equality of characters, respectively"
+            << std::endl
+            << "(defaults shown); gap of k characters costs open + k * del"
+            << std::endl
+            << "(or ins, respectively); open must not be positive."
+            << std::endl
+            << "Negative number means penalisation, match should be positive."
+            << std::endl
+            << std::endl
+            << "If the strings are specified via cmd. line arguments,"
+            << std::endl
+            << "the process will print their alignment."
+            << std::endl
+            << "Otherwise, it expects the strings on its std. input"
+            << std::endl
+            << "(one per each line) and prints the result per each 2 lines."
+            << std::endl
+            << std::endl
+            << "Options:"
+            << std::endl
+            << "  --threads N  compute long alignments by N threads "
+               "(0 means number of CPUs, default: " << threads << ")"
+            << std::endl
+            << "  --parallel-cutoff P"
+            << std::endl
+            << "               compute sub-problems of less than P score"
+               " matrix cells"
+            << std::endl
+            << "               serially (default: "
+            << myers_miller_t::parallel_cutoff_dflt << ")"
+            << std::endl
+            << "  --band K     compute only score matrices band around"
+               " the diagonal,"
+            << std::endl
+            << "               K is the expected max. number of edits"
+               " (0 means unbanded)"
+            << std::endl
+            << "  --leaf C     align sub-problems of up to C score matrix"
+               " cells"
+            << std::endl
+            << "               using full matrices (default: fit CPU cache,"
+               " 0 means never)"
+            << std::endl
+            << "  --cigar      print the alignment as edit script (CIGAR"
+               " string of"
+            << std::endl
+            << "               =, X, D and I runs) instead of the aligned"
+               " strings"
+            << std::endl
+            << "  --stats      print computation statistics to std. error"
+               " at the end"
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    // Read character operation costs
+    if (argc > 1) open_cost = arg2int(argv[1]);
+    if (argc > 2) del_cost  = arg2int(argv[2]);
+    if (argc > 3) ins_cost  = arg2int(argv[3]);
+    if (argc > 4) sub_cost  = arg2int(argv[4]);
+    if (argc > 5) eql_cost  = arg2int(argv[5]);
+
+    if (open_cost > 0) {
+        std::cerr
+            << "Invalid gap opening cost " << open_cost
+            << " (must not be positive)"
+            << std::endl;
+
+        return 1;
+    }
+
+    // Instantiate Myers-Miller algorithm (constant costs)
+    typedef algorithm::string::const_cost const_cost;
+    typedef algorithm::string::match_cost match_cost;
+
+    myers_miller_t myers_miller(
+        open_cost,
+        const_cost(del_cost),
+        const_cost(ins_cost),
+        match_cost(eql_cost, sub_cost));
+
+    myers_miller.band(band);
+    if (par_cut >= 0) myers_miller.parallel_cutoff(par_cut);
+    if (leaf >= 0) myers_miller.leaf_cells(leaf);
+
+    // Thread pool (parallel mode)
+    std::unique_ptr<algorithm::parallel::thread_pool> pool;
+    if (1 != threads) pool.reset(new algorithm::parallel::thread_pool(threads));
+
+    // The workspace is reused
+    algorithm::string::hirschberg_workspace ws;
+    auto align = [&](const std::string & s1, const std::string & s2) {
+        // Edit script is streamed directly to output
+        if (cigar) {
+            algorithm::string::edit_script_stream out(std::cout);
+            if (pool)
+                myers_miller.align(s1.data(), s1.size(), s2.data(), s2.size(),
+                    out, ws, *pool);
+            else
+                myers_miller.align(s1.data(), s1.size(), s2.data(), s2.size(),
+                    out, ws);
+
+            out.flush();
+            std::cout << std::endl;
+
+            return;
+        }
+
+        auto alignment = pool
+            ? myers_miller(s1, s2, ws, *pool)
+            : myers_miller(s1, s2, ws);
+
+        std::cout
+            << std::get<0>(alignment) << std::endl
+            << std::get<1>(alignment) << std::endl;
+    };
+
+    // Strings passed as cmd. line arguments
+    if (8 == argc)
+        align(argv[6], argv[7]);
+
+    // Strings from input
+    else {
+        for (std::string arg1, arg2; ;) {
+            if (std::getline(std::cin, arg1).eof()) break;
+            if (std::getline(std::cin, arg2).eof()) break;
+
+            align(arg1, arg2);
+        }
+    }
+
+    pool.reset();  // finish workers (so that their statistics are final)
+
+    // Computation statistics
+    if (stats) {
+        if (algorithm::string::stats::enabled)
+            algorithm::string::stats::total().print(std::cerr);
+        else
+            std::cerr
+                << "Statistics unavailable (built without ALGORITHM_STATS)"
+                << std::endl;
+    }
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -0,0 +1,216 @@
+/**
+ *  \file
+ *  \brief  Threshold similarity join: CLI
+ *
+ *  \date   2026/10/16
+ *  \author Vaclav Krpec  <vencik@razdva.cz>
+ *
+ *
+ *  LEGAL NOTICE
+ *
+ *  Copyright (c) 2017, Vaclav Krpec
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the distribution.
+ *
+ *  3. Neither the name of the copyright holder nor the names of
+ *     its contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ *  THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ *  PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER
+ *  OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *  PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *  OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *  WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ *  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+
+#include "algorithm/string/simi_join.hxx"
+#include "algorithm/parallel/thread_pool.hxx"
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <cstdio>
+
+
+/** Convert cmd. line argument to integer */
+static int arg2int(const char * arg) {
+    char * err;
+    long i = strtol(arg, &err, 10);
+    if ('\0' != *err || !(INT_MIN <= i && i <= INT_MAX))
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return i;
+}
+
+
+/** Convert cmd. line argument to real number */
+static double arg2real(const char * arg) {
+    char * err;
+    double d = strtod(arg, &err);
+    if ('\0' != *err)
+        throw std::runtime_error(std::string("Invalid argument: ") + arg);
+
+    return d;
+}
+
+
+/**
+ *  \brief  Load strings (one per line)
+ *
+ *  \param  file     File name
+ *  \param  strings  Strings
+ */
+static void load(const char * file, std::vector<std::string> & strings) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) throw std::runtime_error(std::string("Can't open ") + file);
+
+    for (std::string str; std::getline(in, str); )
+        strings.push_back(str);
+}
+
+
+/** CLI wrapper */
+static int main_impl(int argc, char * const argv[]) {
+    int threads = 1;  // Number of threads (0 means number of CPUs)
+    int q       = 2;  // q-gram length
+
+    const char * prog = argv[0];
+
+    // Options
+    bool opts_ok = true;
+    int  opts    = 1;
+    for (; opts < argc && 0 == ::strncmp(argv[opts], "--", 2); ++opts) {
+        const std::string opt(argv[opts]);
+
+        if ("--threads" == opt && opts + 1 < argc) {
+            threads = arg2int(argv[++opts]);
+            if (threads < 0) opts_ok = false;
+        }
+        else if ("--q" == opt && opts + 1 < argc) {
+            q = arg2int(argv[++opts]);
+            if (q < 1 || q > 8) opts_ok = false;
+        }
+        else
+            opts_ok = false;
+    }
+
+    // Shift positional arguments
+    argc -= opts - 1;
+    argv += opts - 1;
+
+    if (!opts_ok || !(3 == argc || 4 == argc)) {
+        std::cerr
+            << "Usage: " << prog << " [--threads N] [--q Q] "
+               "<min_simi> <strings> [<strings_2>]"
+            << std::endl
+            << std::endl
+            << "Levenshtein similarity join: finds all the pairs of strings"
+            << std::endl
+            << "with similarity at least min_simi (in [0, 1])."
+            << std::endl
+            << std::endl
+            << "The strings are read from files (one per line)."
+            << std::endl
+            << "If one file is specified, pairs of its strings are searched"
+            << std::endl
+            << "for; otherwise, pairs of a string from each file are."
+            << std::endl
+            << "Each pair is printed as soon as it's found (in no particular"
+            << std::endl
+            << "order) as the strings' line numbers and their similarity"
+            << std::endl
+            << "(tab-separated)."
+            << std::endl
+            << std::endl
+            << "Options:"
+            << std::endl
+            << "  --threads N  join by N threads "
+               "(0 means number of CPUs, default: " << threads << ")"
+            << std::endl
+            << "  --q Q        q-gram length used for candidates filtering "
+               "(1 to 8, default: " << q << ")"
+            << std::endl
+            << std::endl;
+
+        return 1;
+    }
+
+    const double min_simi = arg2real(argv[1]);
+
+    std::vector<std::string> strings;
+    std::vector<std::string> strings_2;
+
+    load(argv[2], strings);
+    if (4 == argc) load(argv[3], strings_2);
+
+    // Thread pool (parallel mode)
+    std::unique_ptr<algorithm::parallel::thread_pool> pool;
+    if (1 != threads) pool.reset(new algorithm::parallel::thread_pool(threads));
+
+    // Pairs are written as found
+    auto out = [](size_t i, size_t j, double simi) {
+        char result[64];
+        std::cout.write(result, ::snprintf(result, sizeof(result),
+            "%zu\t%zu\t%g\n", i + 1, j + 1, simi));
+    };
+
+    if (4 != argc) {
+        algorithm::string::simi_join join(strings, min_simi, q);
+        join.self_join(out, pool.get());
+    }
+    else {
+        algorithm::string::simi_join join(strings_2, min_simi, q);
+        join.join(strings, out, pool.get());
+    }
+
+    std::cout.flush();
+
+    return 0;
+}
+
+
+/** Exception-safe wrapper */
+int main(int argc, char * const argv[]) {
+    int exit_code = 127;
+
+    try {
+        exit_code = main_impl(argc, argv);
+    }
+    catch (const std::exception & x) {
+        std::cerr
+            << "Standard exception caught: "
+            << x.what()
+            << std::endl;
+    }
+    catch (...) {
+        std::cerr
+            << "Unhandled non-standard exception caught"
+            << std::endl;
+    }
+
+    return exit_code;
+}
@@ -29,3 +29,37 @@ HERE
 
     rm "$in_file" "$x_out_file" "$out_file"
 }
+
+
+# Pseudo-random DNA sequence of length $1 (seed $2)
+random_seq() {
+    awk -v n="$1" -v x="$2" 'BEGIN {
+        for (i = 0; i < n; ++i) {
+            x = (x * 16807) % 2147483647;
+            printf "%s", substr("ACGT", x % 4 + 1, 1);
+        }
+        print "";
+    }'
+}
+
+
+# Mutate sequence on input: every $1-th character is substituted,
+# $2 characters are deleted at position $3 and $2 (pseudo-random)
+# characters are inserted at position $4
+mutate_seq() {
+    awk -v sub_every="$1" -v gap="$2" -v del_at="$3" -v ins_at="$4" '{
+        x = 4242; out = "";
+        for (i = 1; i <= length($0); ++i) {
+            if (i == ins_at)
+                for (k = 0; k < gap; ++k) {
+                    x = (x * 16807) % 2147483647;
+                    out = out substr("ACGT", x % 4 + 1, 1);
+                }
+            if (del_at <= i && i < del_at + gap) continue;
+            c = substr($0, i, 1);
+            if (0 == i % sub_every) c = "A" == c ? "C" : "A";
+            out = out c;
+        }
+        print out;
+    }'
+}
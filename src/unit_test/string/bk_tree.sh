@@ -0,0 +1,50 @@
+#!/bin/sh
+# UT for cli/string/bk_tree
+
+set -e
+
+SOURCE_DIR="$1"
+BUILD_DIR="$2"
+
+. ${SOURCE_DIR}/unit_test/functions.sh
+
+dict="${SOURCE_DIR}/unit_test/string/bk_tree.dict"
+
+
+# Range query
+match "${BUILD_DIR}/cli/string/bk_tree dist 1 ${dict}" "\
+bok
+caqe" \
+"\
+book	1
+boo	1
+
+cake	1
+cape	1
+"
+
+# Nearest neighbours query
+match "${BUILD_DIR}/cli/string/bk_tree nearest 3 ${dict}" "\
+brok" \
+"\
+book	1
+brook	1
+books	2
+"
+
+# Saved index
+index=$(mktemp --tmpdir=${PWD} index.XXXXXXXXXX)
+"${BUILD_DIR}/cli/string/bk_tree" save "${dict}" "${index}"
+
+match "${BUILD_DIR}/cli/string/bk_tree dist 2 ${index}" "\
+cark" \
+"\
+cart	1
+bark	1
+cook	2
+cake	2
+cape	2
+back	2
+"
+
+rm "${index}"
@@ -15,3 +15,109 @@ TATGC" \
 "\
 AGTACGCA
 --TATGC-"
+
+# Longer strings (vectorised score rows)
+match "${BUILD_DIR}/cli/string/hirschberg" "\
+GATTACAGATTACACCTGAGGTCATTAGCA
+GATACAGATTTACACTGAGGTCTATTAGCA" \
+"\
+GATTACAGATT-ACACCTGAGGTC-ATTAGCA
+GA-TACAGATTTACA-CTGAGGTCTATTAGCA"
+
+# Parallel computation (forks down to sub-problems of 1024 cells,
+# the alignment is the same as the serial one)
+seq1=$(random_seq 600 7)
+seq2=$(echo "${seq1}" | mutate_seq 37 24 100 450)
+
+match "${BUILD_DIR}/cli/string/hirschberg --threads 4 --leaf 0 --parallel-cutoff 1024" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/hirschberg --leaf 0)"
+
+match "${BUILD_DIR}/cli/string/hirschberg --threads 4 --leaf 0 --parallel-cutoff 1024 --cigar" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/hirschberg --leaf 0 --cigar)"
+
+# Banded computation (the 24 characters long gaps take the optimal
+# path far out of the band, so it must be widened; the alignment
+# score must be the same as the unbanded one)
+alignment_score() {
+    awk 'NR % 2 { a = $0; next } {
+        score = 0;
+        for (i = 1; i <= length(a); ++i) {
+            c1 = substr(a, i, 1); c2 = substr($0, i, 1);
+            if ("-" == c1 || "-" == c2) score -= 2;
+            else score += c1 == c2 ? 2 : -1;
+        }
+        gsub("-", "", a); gsub("-", "");
+        print score; print a; print $0;
+    }'
+}
+
+match "${BUILD_DIR}/cli/string/hirschberg --band 2 --leaf 0 | alignment_score" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/hirschberg --leaf 0 | alignment_score)"
+
+# Recursion down to single characters (no full score matrix leaves)
+match "${BUILD_DIR}/cli/string/hirschberg --leaf 0" "\
+GATTACAGATTACACCTGAGGTCATTAGCA
+GATACAGATTTACACTGAGGTCTATTAGCA" \
+"\
+GATTACAGATT-ACACCTGAGGTC-ATTAGCA
+GA-TACAGATTTACA-CTGAGGTCTATTAGCA"
+
+# Edit script (CIGAR) output
+match "${BUILD_DIR}/cli/string/hirschberg --cigar" "\
+GATTACAGATTACACCTGAGGTCATTAGCA
+GATACAGATTTACACTGAGGTCTATTAGCA" \
+"\
+2=1D8=1I3=1D8=1I7="
+
+# Memory-mapped FASTA files (streamed in blocks)
+fasta1=$(mktemp --tmpdir=${PWD} fasta1.XXXXXXXXXX)
+fasta2=$(mktemp --tmpdir=${PWD} fasta2.XXXXXXXXXX)
+
+printf '>seq1 test\nGATTACAGATTACA\nCCTGAGGTCATTAGCA\n>seq2\nAAAA\n' \
+    > "${fasta1}"
+printf ';comment\r\n>x\r\nGATACAGATTTACACTG\r\nAGGTCTATTAGCA\r\n' \
+    > "${fasta2}"
+
+match "${BUILD_DIR}/cli/string/hirschberg --files ${fasta1} ${fasta2} --fasta --width 10" "" \
+"\
+GATTACAGAT
+GA-TACAGAT
+
+T-ACACCTGA
+TTACA-CTGA
+
+GGTC-ATTAG
+GGTCTATTAG
+
+CA
+CA
+"
+
+match "${BUILD_DIR}/cli/string/hirschberg --files ${fasta1} ${fasta2} --fasta --cigar --threads 2" "" \
+"\
+2=1D8=1I3=1D8=1I7="
+
+# Single line FASTA sequence (used in place)
+printf '>seq1\nGATTACAGATTACACCTGAGGTCATTAGCA\n' > "${fasta1}"
+
+match "${BUILD_DIR}/cli/string/hirschberg --files ${fasta1} ${fasta2} --fasta --cigar" "" \
+"\
+2=1D8=1I3=1D8=1I7="
+
+# Empty lines around the sequence are skipped
+printf '>seq1\n\nGATTACAGATTACACCTGAGGTCATTAGCA\n\r\n\n' > "${fasta1}"
+
+match "${BUILD_DIR}/cli/string/hirschberg --files ${fasta1} ${fasta2} --fasta --cigar" "" \
+"\
+2=1D8=1I3=1D8=1I7="
+
+rm "${fasta1}" "${fasta2}"
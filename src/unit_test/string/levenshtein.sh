@@ -17,3 +17,140 @@ Saturday" \
 "\
 3
 3"
+
+# Long strings (multi-word bit-vectors)
+match "${BUILD_DIR}/cli/string/levenshtein dist" "\
+The quick brown fox jumps over the lazy dog; the lazy dog sleeps on.
+The quick brown cat jumped over a lazy dog, and the lazy dog slept on.
+Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation.
+Lorem ipsum dolor sit amet, consectetuer adipiscing elit, sed diam nonummy nibh euismod tincidunt ut laoreet dolore magna aliquam erat volutpat. Ut wisi enim ad minim veniam.
+The quick brown fox jumps over the lazy dog; the lazy dog sleeps on.
+Lorem ipsum dolor sit amet, consectetuer adipiscing elit, sed diam nonummy nibh euismod tincidunt ut laoreet dolore magna aliquam erat volutpat. Ut wisi enim ad minim veniam." \
+"\
+15
+66
+141"
+
+# Batch mode (parallel, thresholded)
+match "${BUILD_DIR}/cli/string/levenshtein --batch --threads 2 dist" "\
+sitting
+kitten
+Sunday
+Saturday
+flaw
+lawn" \
+"\
+3
+3
+2"
+
+match "${BUILD_DIR}/cli/string/levenshtein --input /dev/stdin --threshold 2 dist" "\
+sitting
+kitten
+Sunday
+Saturday
+flaw
+lawn" \
+"\
+3
+3
+2"
+
+match "${BUILD_DIR}/cli/string/levenshtein --batch --threshold 0.55 simi" "\
+kitten
+sitting
+flaw
+lawn" \
+"\
+0.571429
+0"
+
+# Unreachable similarity threshold
+match "${BUILD_DIR}/cli/string/levenshtein --batch --threshold 1.5 simi" "\
+kitten
+kitten" \
+"\
+0"
+
+# Thresholds not representable as distances are rejected
+match "${BUILD_DIR}/cli/string/levenshtein --threshold 1e30 dist kitten sitting 2>/dev/null || echo rejected" "" \
+"\
+rejected"
+
+match "${BUILD_DIR}/cli/string/levenshtein --threshold nan simi kitten sitting 2>/dev/null || echo rejected" "" \
+"\
+rejected"
+
+# UTF-8 strings (distance in characters, not bytes)
+match "${BUILD_DIR}/cli/string/levenshtein --utf8 dist" "\
+naïve café
+naive cafe
+żółw
+zolw
+kitten
+sitting" \
+"\
+2
+3
+3"
+
+# Edit script (CIGAR)
+match "${BUILD_DIR}/cli/string/levenshtein script" "\
+kitten
+sitting
+flaw
+lawn" \
+"\
+1X3=1X1=1I
+1D3=1I"
+
+# String sets (sizes not aligned to the batch tiles) against pairwise results
+random_seqs() {
+    awk -v n="$1" -v x="$2" 'BEGIN {
+        for (i = 0; i < n; ++i) {
+            x = (x * 16807) % 2147483647;
+            len = x % 150; s = "";
+            for (k = 0; k < len; ++k) {
+                x = (x * 16807) % 2147483647;
+                s = s substr("ACGT", x % 4 + 1, 1);
+            }
+            print s;
+        }
+    }'
+}
+
+rows=$(random_seqs 19 1)
+cols=$(mktemp --tmpdir=${PWD} cols.XXXXXXXXXX)
+random_seqs 261 2 > "$cols"
+
+match "${BUILD_DIR}/cli/string/levenshtein --query ACGTTGCAACGT dist" \
+"$(cat "$cols")" \
+"$(awk '{ print "ACGTTGCAACGT"; print }' "$cols" |
+    ${BUILD_DIR}/cli/string/levenshtein --batch dist)"
+
+match "${BUILD_DIR}/cli/string/levenshtein --query ACGTTGCAACGT simi" \
+"$(cat "$cols")" \
+"$(awk '{ print "ACGTTGCAACGT"; print }' "$cols" |
+    ${BUILD_DIR}/cli/string/levenshtein --batch simi)"
+
+match "${BUILD_DIR}/cli/string/levenshtein --threads 3 --matrix $cols dist" \
+"$rows" \
+"$(echo "$rows" |
+    awk 'NR == FNR { c[n++] = $0; next }
+        { for (j = 0; j < n; ++j) { print; print c[j] } }' "$cols" - |
+    ${BUILD_DIR}/cli/string/levenshtein --batch dist |
+    awk '{ printf "%s%s", $0, NR % 261 ? "\t" : "\n" }')"
+
+match "${BUILD_DIR}/cli/string/levenshtein --threads 3 --all-pairs dist" \
+"$(cat "$cols")" \
+"$(awk '{ s[n++] = $0 }
+        END { for (i = 0; i < n; ++i) for (j = i + 1; j < n; ++j)
+            { print s[i]; print s[j] } }' "$cols" |
+    ${BUILD_DIR}/cli/string/levenshtein --batch dist |
+    awk -v n=261 '{
+        if (0 == k) { row = $0; k = n - 2 - i++ }
+        else { row = row "\t" $0; --k }
+        if (0 == k) print row
+    }')"
+
+rm "$cols"
@@ -0,0 +1,35 @@
+#!/bin/sh
+# UT for cli/string/levenshtein_filter
+
+set -e
+
+SOURCE_DIR="$1"
+BUILD_DIR="$2"
+
+. ${SOURCE_DIR}/unit_test/functions.sh
+
+
+match "${BUILD_DIR}/cli/string/levenshtein_filter kitten 2" "\
+kitten
+sitting
+mitten
+kitchen
+smitten
+kit" \
+"\
+kitten	0
+mitten	1
+kitchen	2
+smitten	2"
+
+# Max. threshold (row entries capped at 255 must not wrap)
+repeat() { printf "%${2}s" | tr ' ' "$1"; }
+
+match "${BUILD_DIR}/cli/string/levenshtein_filter $(repeat a 256) 254 | cut -f 2" "\
+aa
+a
+$(repeat b 254)aa
+$(repeat b 255)a" \
+"\
+254
+254"
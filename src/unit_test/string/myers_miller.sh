@@ -0,0 +1,98 @@
+#!/bin/sh
+# UT for cli/string/myers_miller
+
+set -e
+
+SOURCE_DIR="$1"
+BUILD_DIR="$2"
+
+. ${SOURCE_DIR}/unit_test/functions.sh
+
+
+# Affine gap costs prefer a single long gap
+match "${BUILD_DIR}/cli/string/myers_miller" "\
+AAAACCCCGGGGTTTT
+AAAAGGGGTTTT" \
+"\
+AAAACCCCGGGGTTTT
+AAAA----GGGGTTTT"
+
+match "${BUILD_DIR}/cli/string/myers_miller --cigar" "\
+AAAACCCCGGGGTTTT
+AAAAGGGGTTTT" \
+"\
+4=4D8="
+
+# Longer strings
+match "${BUILD_DIR}/cli/string/myers_miller" "\
+GATTACAGATTACACCTGAGGTCATTAGCA
+GATACAGATTTACACTGAGGTCTATTAGCA" \
+"\
+GATTACAGA-TTACACCTGAGGTC-ATTAGCA
+GA-TACAGATTTACA-CTGAGGTCTATTAGCA"
+
+# Parallel computation (forks down to sub-problems of 1024 cells,
+# the alignment is the same as the serial one)
+seq1=$(random_seq 600 7)
+seq2=$(echo "${seq1}" | mutate_seq 37 24 100 450)
+
+match "${BUILD_DIR}/cli/string/myers_miller --threads 4 --leaf 0 --parallel-cutoff 1024" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/myers_miller --leaf 0)"
+
+# Banded computation (the band must be widened to reach the gaps;
+# the alignment score must be the same as the unbanded one)
+alignment_score() {
+    awk 'NR % 2 { a = $0; next } {
+        score = 0; state = "";
+        for (i = 1; i <= length(a); ++i) {
+            c1 = substr(a, i, 1); c2 = substr($0, i, 1);
+            if ("-" == c1) {
+                score += "i" == state ? -1 : -4; state = "i";
+            }
+            else if ("-" == c2) {
+                score += "d" == state ? -1 : -4; state = "d";
+            }
+            else {
+                score += c1 == c2 ? 2 : -1; state = "";
+            }
+        }
+        gsub("-", "", a); gsub("-", "");
+        print score; print a; print $0;
+    }'
+}
+
+match "${BUILD_DIR}/cli/string/myers_miller --band 2 --leaf 0 | alignment_score" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/myers_miller --leaf 0 | alignment_score)"
+
+match "${BUILD_DIR}/cli/string/myers_miller --band 2 --leaf 0 --threads 4 --parallel-cutoff 1024 | alignment_score" "\
+${seq1}
+${seq2}" \
+"$(printf '%s\n%s\n' "${seq1}" "${seq2}" |
+    ${BUILD_DIR}/cli/string/myers_miller --leaf 0 | alignment_score)"
+
+# Recursion down to single characters (no full score matrices leaves)
+match "${BUILD_DIR}/cli/string/myers_miller --leaf 0 --cigar" "\
+GATTACAGATTACACCTGAGGTCATTAGCA
+GATACAGATTTACACTGAGGTCTATTAGCA
+AAAACCCCGGGGTTTT
+AAAAGGGGTTTT" \
+"\
+2=1D8=1I3=1D8=1I7=
+4=4D8="
+
+# Gap spanning the division (costs and strings as arguments)
+match "${BUILD_DIR}/cli/string/myers_miller --leaf 0 -10 -1 -1 -1 2 ACGTTTTTTTTACGT ACGTACGT" "" \
+"\
+ACGTTTTTTTTACGT
+ACG-------TACGT"
+
+# Positive gap opening cost is rejected
+match "${BUILD_DIR}/cli/string/myers_miller 2 0 -1 -1 0 AB AAB 2>/dev/null || echo rejected" "" \
+"\
+rejected"
@@ -0,0 +1,53 @@
+#!/bin/sh
+# UT for cli/string/simi_join
+
+set -e
+
+SOURCE_DIR="$1"
+BUILD_DIR="$2"
+
+. ${SOURCE_DIR}/unit_test/functions.sh
+
+dict="${SOURCE_DIR}/unit_test/string/bk_tree.dict"
+
+
+# Self-join
+match "${BUILD_DIR}/cli/string/simi_join 0.75 ${dict} | sort -n" "" \
+"\
+1	2	0.8
+1	3	0.75
+1	4	0.75
+1	5	0.75
+1	9	0.8
+3	4	0.75
+6	7	0.75
+10	11	0.75"
+
+# Parallel self-join
+match "${BUILD_DIR}/cli/string/simi_join --threads 4 --q 1 0.75 ${dict} | sort -n" "" \
+"\
+1	2	0.8
+1	3	0.75
+1	4	0.75
+1	5	0.75
+1	9	0.8
+3	4	0.75
+6	7	0.75
+10	11	0.75"
+
+# Join of 2 sets
+match "${BUILD_DIR}/cli/string/simi_join 0.6 /dev/stdin ${dict} | sort -n" "\
+bok
+caqe" \
+"\
+1	1	0.75
+1	2	0.6
+1	3	0.666667
+1	9	0.6
+2	6	0.75
+2	7	0.75"
+
+# Join with an empty set
+match "${BUILD_DIR}/cli/string/simi_join 0.6 ${dict} /dev/null | wc -l" "" \
+"\
+0"